@@ -37,1943 +37,4484 @@ bool isValidIntInput(int &input)
     return true;
 }
 
-bool isValidDate(int year, int month, int day)
+const string &categoryName(int category)
 {
-    static const int daysInMonth[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
-    if (month < 1 || month > 12)
-        return false;
-    if (day < 1)
-        return false;
-    if (month == 2 && ((year % 4 == 0 && year % 100 != 0) || (year % 400 == 0)))
-        return day <= 29;
-    return day <= daysInMonth[month - 1];
+    return ledger.categoryNames[category];
 }
 
-void detectFraudulentTransactions()
+string cardName(int card)
+{
+    if (card > 0 && card < (int)defaultCreditCards.size())
+        return defaultCreditCards[card].name;
+    return card == 0 ? "-" : to_string(card);
+}
+
+map<string, bool> loadCategoryConfig(const string &configFile)
 {
-    vector<double> essentialSum(3, 0), nonEssentialSum(3, 0);
-    vector<int> essentialCount(3, 0), nonEssentialCount(3, 0);
-    for (int month = 0; month < 12; month++)
+    map<string, bool> config = defaultEssentialCategories;
+    ifstream file(configFile);
+    string name, kind;
+    while (file >> name >> kind)
     {
-        for (int day = 0; day < 31; day++)
-        {
-            for (int i = 0; i < 3; i++)
-            {
-                if (expenseData[month][day].first[i] > 0)
-                {
-                    essentialSum[i] += expenseData[month][day].first[i];
-                    essentialCount[i]++;
-                }
-                if (expenseData[month][day].second[i] > 0)
-                {
-                    nonEssentialSum[i] += expenseData[month][day].second[i];
-                    nonEssentialCount[i]++;
-                }
-            }
-        }
+        if (kind == "essential")
+            config[name] = true;
+        else if (kind == "nonessential")
+            config[name] = false;
+        else
+            cerr << "Warning: Unknown category kind '" << kind << "' for " << name << " in " << configFile << endl;
     }
-    vector<double> essentialMean(3, 0), nonEssentialMean(3, 0);
-    vector<double> essentialSD(3, 0), nonEssentialSD(3, 0);
-    for (int i = 0; i < 3; i++)
+    return config;
+}
+
+// Versions come from one process-wide counter, so no two ledger states ever share one and a
+// cache keyed on the version alone cannot serve a stale answer.
+void Ledger::touch()
+{
+    static atomic<uint64_t> versions(0);
+    version = ++versions;
+}
+
+void Ledger::setCategories(const vector<string> &names, const map<string, bool> &essentialConfig)
+{
+    touch();
+    categoryNames = names;
+    categoryCount = names.size();
+    essential.assign(categoryCount, 1);
+    stats.assign(categoryCount, CategoryStats());
+    totals.assign(categoryCount, FenwickTree());
+    rebuildTotals();
+    for (int c = 0; c < categoryCount; c++)
     {
-        if (essentialCount[i] > 0)
-            essentialMean[i] = essentialSum[i] / essentialCount[i];
-        if (nonEssentialCount[i] > 0)
-            nonEssentialMean[i] = nonEssentialSum[i] / nonEssentialCount[i];
+        auto it = essentialConfig.find(names[c]);
+        if (it != essentialConfig.end())
+            essential[c] = it->second;
     }
-    for (int month = 0; month < 12; month++)
+}
+
+int Ledger::findCategory(const string &name) const
+{
+    for (int c = 0; c < categoryCount; c++)
     {
-        for (int day = 0; day < 31; day++)
-        {
-            for (int i = 0; i < 3; i++)
-            {
-                if (expenseData[month][day].first[i] > 0)
-                {
-                    essentialSD[i] += pow(expenseData[month][day].first[i] - essentialMean[i], 2);
-                }
-                if (expenseData[month][day].second[i] > 0)
-                {
-                    nonEssentialSD[i] += pow(expenseData[month][day].second[i] - nonEssentialMean[i], 2);
-                }
-            }
-        }
+        if (categoryNames[c] == name)
+            return c;
     }
-    for (int i = 0; i < 3; i++)
+    return -1;
+}
+
+void Ledger::setYears(int first, int count)
+{
+    firstYear = first;
+    yearCount = count;
+    origin = Date::fromCivil(first, 1, 1);
+    days = count == 0 ? 0 : Date::daysBetweenYears(first, first + count);
+}
+
+void Ledger::ensureYear(int year)
+{
+    if (hasYear(year))
+        return;
+    int newFirst = yearCount == 0 ? year : min(firstYear, year);
+    int newCount = yearCount == 0 ? 1 : max(firstYear + yearCount, year + 1) - newFirst;
+    size_t newDays = Date::daysBetweenYears(newFirst, newFirst + newCount);
+    size_t offset = yearCount == 0 ? 0 : Date::daysBetweenYears(newFirst, firstYear);
+    vector<int> newAmounts(newDays * categoryCount, 0);
+    vector<int> newCards(newDays * categoryCount, 0);
+    for (int c = 0; c < categoryCount && yearCount > 0; c++)
     {
-        if (essentialCount[i] > 1)
-            essentialSD[i] = sqrt(essentialSD[i] / essentialCount[i]);
-        if (nonEssentialCount[i] > 1)
-            nonEssentialSD[i] = sqrt(nonEssentialSD[i] / nonEssentialCount[i]);
+        copy(amountColumn(c), amountColumn(c) + dayCount(), newAmounts.begin() + c * newDays + offset);
+        copy(cardColumn(c), cardColumn(c) + dayCount(), newCards.begin() + c * newDays + offset);
     }
-    bool fraudDetected = false;
-    stringstream output;
-    for (int month = 0; month < 12; month++)
+    amounts.swap(newAmounts);
+    cards.swap(newCards);
+    setYears(newFirst, newCount);
+    rebuildTotals();
+}
+
+void Ledger::merge(const Ledger &other)
+{
+    if (other.yearCount == 0)
+        return;
+    ensureYear(other.firstYear);
+    ensureYear(other.firstYear + other.yearCount - 1);
+    int offset = dayIndex(other.firstYear, 0, 0);
+    int otherDays = other.dayCount();
+    for (int c = 0; c < categoryCount; c++)
     {
-        for (int day = 0; day < 31; day++)
+        int *amountDst = &amount(c, offset);
+        int *cardDst = &card(c, offset);
+        const int *amountSrc = other.amountColumn(c);
+        const int *cardSrc = other.cardColumn(c);
+        CategoryStats &columnStats = stats[c];
+        columnStats.merge(other.stats[c]);
+        for (int d = 0; d < otherDays; d++)
         {
-            for (int i = 0; i < 3; i++)
+            if (amountDst[d] != 0 && amountSrc[d] != 0)
             {
-                if (expenseData[month][day].first[i] > essentialMean[i] + 2 * essentialSD[i])
-                {
-                    if (!fraudDetected)
-                    {
-                        fraudDetected = true;
-                        output << "\nDetecting Fraudulent Transactions...\n";
-                        Sleep(500);
-                        output << "\nFlagged Transactions:\n";
-                        output << "-------------------------------------------------\n";
-                        output << "|    Date    | Category |  Amount  |   Status   |\n";
-                        output << "-------------------------------------------------\n";
-                    }
-                    output << "| 2024-"
-                           << setfill('0') << setw(2) << month + 1 << "-"
-                           << setw(2) << day + 1;
-                    output << setfill(' ') << " | "
-                           << left << setw(8) << essentialCategories[i] << " | "
-                           << right << setw(8) << expenseData[month][day].first[i] << " | "
-                           << left << setw(10) << "Fraudulent" << " |\n";
-                }
+                columnStats.replace(amountDst[d], 0);
+                columnStats.replace(amountSrc[d], amountDst[d] + amountSrc[d]);
             }
+            amountDst[d] += amountSrc[d];
+            if (cardSrc[d] != 0)
+                cardDst[d] = cardSrc[d];
         }
     }
-    if (fraudDetected)
+    rebuildTotals();
+}
+
+bool Ledger::hasExpense(int day) const
+{
+    for (int c = 0; c < categoryCount; c++)
     {
-        output << "-------------------------------------------------\n";
-        cout << output.str();
+        if (amount(c, day) > 0)
+            return true;
     }
+    return false;
 }
 
-void parseCSV(const string &filename, vector<vector<pair<vector<int>, vector<int>>>> &vec, vector<int> &monthlyTotals)
+void Ledger::setAmount(int category, int day, int value)
 {
-    ifstream file(filename);
-    if (!file.is_open())
+    int &cell = amount(category, day);
+    if (cell == value)
+        return;
+    SavingsReach *reach = savingsReach.get();
+    bool reachCurrent = reach && reach->current(*this);
+    if (reachCurrent && !essential[category])
+        reach->replace(cell, value);
+    RollingEditWindows *edits = rollingWindows.get();
+    bool editsCurrent = edits && edits->current(*this);
+    if (editsCurrent)
+        edits->update(card(category, day), category, day, cell, value);
+    stats[category].replace(cell, value);
+    if (!totals.empty())
+        totals[category].add(day, (long long)value - cell);
+    cell = value;
+    touch();
+    if (reachCurrent)
+        reach->version = version;
+    if (editsCurrent)
+        edits->version = version;
+    if (!alertStream)
+        return;
+    if (isAnomalous(category, value))
+        alertStream->publish(thresholdAlert(category, day, value));
+    FraudAlert alert;
+    if (isRollingAnomaly(category, day, value, alert))
+        alertStream->publish(alert);
+}
+FraudAlert Ledger::thresholdAlert(int category, int day, int value) const
+{
+    const CategoryStats &columnStats = stats[category];
+    double score = columnStats.stddev() > 0 ? (value - columnStats.mean) / columnStats.stddev() : 0;
+    return {day, category, value, columnStats.threshold(), card(category, day), 0, score};
+}
+// The window holds the same card's earlier amounts in this category, from the cached edit
+// window for that card, which setAmount and setCard keep current.
+bool Ledger::isRollingAnomaly(int category, int day, int value, FraudAlert &alert)
+{
+    if (rolling.window <= 0 || value <= 0)
+        return false;
+    RollingEditWindows &edits = rollingWindows.obtain();
+    if (!edits.current(*this))
+        edits.reset(*this);
+    int cardId = card(category, day);
+    const WindowQuantiles &window = edits.slide(*this, cardId, category, day);
+    if (window.size < rolling.minSamples)
+        return false;
+    double threshold = rolling.threshold(window);
+    if (value <= threshold)
+        return false;
+    alert = {day, category, value, threshold, cardId, rolling.window, (value - window.quantile(1)) / rolling.spread(window)};
+    return true;
+}
+// Moves a positive amount between the cached windows of its old and new card.
+void Ledger::setCard(int category, int day, int id)
+{
+    int &cell = card(category, day);
+    if (cell == id)
+        return;
+    RollingEditWindows *edits = rollingWindows.get();
+    int value = amount(category, day);
+    if (edits && edits->current(*this) && value > 0)
+    {
+        edits->update(cell, category, day, value, 0);
+        edits->update(id, category, day, 0, value);
+    }
+    cell = id;
+}
+void Ledger::clearDay(int day)
+{
+    for (int c = 0; c < categoryCount; c++)
+    {
+        setAmount(c, day, 0);
+        setCard(c, day, 0);
+    }
+}
+// Records are bump-allocated into fixed blocks that never move, so copies of the store share
+// the blocks and only ever read the records they counted. Appending is copy-on-write: a tail
+// block another copy still holds is cloned before the first write into it, so two copies that
+// both append never overwrite each other's records.
+size_t TransactionStore::append(const Transaction &record)
+{
+    size_t block = count / TRANSACTION_BLOCK_SIZE, slot = count % TRANSACTION_BLOCK_SIZE;
+    if (block == blocks.size())
+        blocks.emplace_back(new Transaction[TRANSACTION_BLOCK_SIZE]);
+    else if (blocks[block].use_count() > 1)
+    {
+        shared_ptr<Transaction[]> owned(new Transaction[TRANSACTION_BLOCK_SIZE]);
+        copy(blocks[block].get(), blocks[block].get() + slot, owned.get());
+        blocks[block] = owned;
+    }
+    blocks[block][slot] = record;
+    return count++;
+}
+uint32_t TransactionStore::internMerchant(string_view name)
+{
+    auto it = merchantIds.find(name);
+    if (it != merchantIds.end())
+        return it->second;
+    // A shared block is left as it is: its names are already referenced by another copy.
+    if (merchantBlocks.empty() || merchantBlocks.back().use_count() > 1 || merchantUsed + name.size() > MERCHANT_BLOCK_SIZE)
+    {
+        merchantBlocks.emplace_back(new char[max<size_t>(name.size(), MERCHANT_BLOCK_SIZE)]);
+        merchantUsed = 0;
+    }
+    char *text = merchantBlocks.back().get() + merchantUsed;
+    if (!name.empty())
+        memcpy(text, name.data(), name.size());
+    merchantUsed += name.size();
+    if (name.size() > MERCHANT_BLOCK_SIZE)
+        merchantUsed = MERCHANT_BLOCK_SIZE;
+    uint32_t id = merchants.size();
+    merchants.emplace_back(text, name.size());
+    merchantIds.emplace(merchants.back(), id);
+    return id;
+}
+// The day x category grid is the materialized sum of the transactions on top of the imported
+// opening balances, so every transaction goes through here to keep the view, its statistics
+// and its range totals current.
+size_t Ledger::addTransaction(const Transaction &record)
+{
+    ensureYear(record.date.year());
+    int day = dayOf(record.date);
+    size_t id = transactions.append(record);
+    if (record.kind == TRANSACTION_PURCHASE && record.card > 0)
+        setCard(record.category, day, record.card);
+    addAmount(record.category, day, record.amount);
+    return id;
+}
+void Ledger::rebuildStats()
+{
+    const AnomalyKernel &kernel = anomalyKernel();
+    stats.resize(categoryCount);
+    for (int c = 0; c < categoryCount; c++)
+        stats[c] = kernel.statistics(amountColumn(c), dayCount());
+}
+// Chunk ledgers carry no trees; a ledger gets them from setCategories and rebuilds them
+// in O(days) whenever its columns are re-laid out or merged.
+void Ledger::rebuildTotals()
+{
+    touch();
+    for (int c = 0; c < (int)totals.size(); c++)
+        totals[c].build(amountColumn(c), dayCount());
+}
+long long Ledger::rangeTotal(int firstDay, int endDay) const
+{
+    long long total = 0;
+    for (int c = 0; c < categoryCount; c++)
+        total += rangeTotal(c, firstDay, endDay);
+    return total;
+}
+// Months are 0-based as in dayIndex; a year the ledger does not hold spent nothing.
+long long Ledger::monthTotal(int year, int month) const
+{
+    if (!hasYear(year))
+        return 0;
+    int first = dayIndex(year, month, 0);
+    return rangeTotal(first, first + Date::daysInMonth(year, month + 1));
+}
+// The month of the last day with an expense, or the ledger's last month when it has none.
+void Ledger::latestMonth(int &year, int &month) const
+{
+    int day = dayCount() - 1;
+    while (day >= 0 && !hasExpense(day))
+        day--;
+    if (day < 0)
+        day = dayCount() - 1;
+    if (day < 0)
     {
-        cerr << "Error: Cannot open file " << filename << endl;
+        year = month = 0;
         return;
     }
-    string line;
-    getline(file, line);
-    while (getline(file, line))
+    int dayOfMonth;
+    dateOf(day).civil(year, month, dayOfMonth);
+    month--;
+}
+// The most recent year in which month is not after the ledger's latest month.
+int Ledger::latestYearOf(int month) const
+{
+    int year, latest;
+    latestMonth(year, latest);
+    return month <= latest ? year : year - 1;
+}
+void FenwickTree::build(const int *values, int count)
+{
+    tree.assign(values, values + count);
+    for (int i = 0; i < count; i++)
     {
-        stringstream ss(line);
-        string fullDate, amountStr;
-        getline(ss, fullDate, ',');
-        if (fullDate.length() < 10)
-        {
-            cerr << "Warning: Invalid date format in row: " << line << endl;
-            continue;
-        }
-        int month = stoi(fullDate.substr(5, 2)) - 1;
-        int day = stoi(fullDate.substr(8, 2)) - 1;
-        if (month < 0 || month > 11 || day < 0 || day > 30)
+        int parent = i | (i + 1);
+        if (parent < count)
+            tree[parent] += tree[i];
+    }
+}
+void FenwickTree::add(int index, long long delta)
+{
+    for (; index < (int)tree.size(); index |= index + 1)
+        tree[index] += delta;
+}
+long long FenwickTree::prefix(int end) const
+{
+    long long sum = 0;
+    for (int i = end - 1; i >= 0; i = (i & (i + 1)) - 1)
+        sum += tree[i];
+    return sum;
+}
+void CategoryStats::add(double value)
+{
+    count++;
+    double delta = value - mean;
+    mean += delta / count;
+    m2 += delta * (value - mean);
+}
+void CategoryStats::remove(double value)
+{
+    if (count <= 1)
+    {
+        *this = CategoryStats();
+        return;
+    }
+    double delta = value - mean;
+    count--;
+    mean -= delta / count;
+    m2 = max(0.0, m2 - delta * (value - mean));
+}
+void CategoryStats::merge(const CategoryStats &other)
+{
+    if (other.count == 0)
+        return;
+    long long total = count + other.count;
+    double delta = other.mean - mean;
+    mean += delta * other.count / total;
+    m2 += other.m2 + delta * delta * count * other.count / total;
+    count = total;
+}
+
+void WindowQuantiles::insert(int value)
+{
+    int bucket = 0;
+    while (bucket < WINDOW_QUANTILE_CUTS && (buckets[bucket].empty() || *buckets[bucket].rbegin() < value))
+        bucket++;
+    buckets[bucket].insert(value);
+    size++;
+    rebalance();
+}
+void WindowQuantiles::erase(int value)
+{
+    for (multiset<int> &bucket : buckets)
+    {
+        auto it = bucket.find(value);
+        if (it != bucket.end())
         {
-            cerr << "Warning: Invalid date in row: " << line << endl;
-            continue;
+            bucket.erase(it);
+            size--;
+            rebalance();
+            return;
         }
-        for (size_t i = 0; i < essentialCategories.size(); i++)
+    }
+}
+// Bucket i ends at the rank of cut i, so each cut value is the largest element of its bucket.
+// An insert or erase moves every cut rank by at most one, so this is a constant number of O(log w) moves.
+void WindowQuantiles::rebalance()
+{
+    int below = 0;
+    for (int i = 0; i < WINDOW_QUANTILE_CUTS; i++)
+    {
+        int target = size == 0 ? 0 : (int)floor(windowQuantileCuts[i] * (size - 1)) + 1;
+        below += (int)buckets[i].size();
+        while (below > target)
         {
-            if (getline(ss, amountStr, ','))
-            {
-                try
-                {
-                    int amount = stoi(amountStr);
-                    vec[month][day].first[i] += amount;
-                    if (filename == "OctExpenses.csv")
-                    {
-                        monthlyTotals[month] += amount;
-                    }
-                }
-                catch (...)
-                {
-                    cerr << "Warning: Invalid amount in row: " << line << endl;
-                }
-            }
+            auto last = prev(buckets[i].end());
+            buckets[i + 1].insert(*last);
+            buckets[i].erase(last);
+            below--;
         }
-        for (size_t i = 0; i < nonEssentialCategories.size(); i++)
+        while (below < target)
         {
-            if (getline(ss, amountStr, ','))
-            {
-                try
-                {
-                    int amount = stoi(amountStr);
-                    vec[month][day].second[i] += amount;
-                    if (filename == "OctExpenses.csv")
-                    {
-                        monthlyTotals[month] += amount;
-                    }
-                }
-                catch (...)
-                {
-                    cerr << "Warning: Invalid amount in row: " << line << endl;
-                }
-            }
+            int next = i + 1;
+            while (buckets[next].empty())
+                next++;
+            buckets[i].insert(*buckets[next].begin());
+            buckets[next].erase(buckets[next].begin());
+            below++;
         }
     }
-    Sleep(2000);
-    if (filename != "carddetails.csv")
+}
+double WindowQuantiles::quantile(int cut) const
+{
+    if (size == 0)
+        return 0;
+    double rank = windowQuantileCuts[cut] * (size - 1);
+    int bucket = cut;
+    while (buckets[bucket].empty())
+        bucket--;
+    double value = *buckets[bucket].rbegin();
+    double fraction = rank - floor(rank);
+    for (int next = cut + 1; next <= WINDOW_QUANTILE_CUTS && fraction > 0; next++)
     {
-        cout << "Parsing CSV file...\n";
-        Sleep(2000);
-        cout << "Parsing expenses details completed successfully!\n";
-        detectFraudulentTransactions();
+        if (!buckets[next].empty())
+            return value + fraction * (*buckets[next].begin() - value);
     }
-    else
+    return value;
+}
+double RollingDetectorOptions::spread(const WindowQuantiles &quantiles) const
+{
+    return max({quantiles.quantile(2) - quantiles.quantile(0), minSpread * quantiles.quantile(1), 1.0});
+}
+bool RollingWindowDetector::observe(int day, int category, int card, int amount, FraudAlert &alert)
+{
+    if (amount <= 0)
+        return false;
+    RollingWindow &window = windows[{card, category}];
+    while (!window.entries.empty() && window.entries.front().first <= day - options.window)
     {
-        cout << "\nParsing card details completed successfully!\n";
+        window.quantiles.erase(window.entries.front().second);
+        window.entries.pop_front();
     }
-    Sleep(2000);
-    file.close();
+    bool flagged = false;
+    if (window.quantiles.size >= options.minSamples)
+    {
+        double threshold = options.threshold(window.quantiles);
+        if (amount > threshold)
+        {
+            alert = {day, category, amount, threshold, card, options.window, (amount - window.quantiles.quantile(1)) / options.spread(window.quantiles)};
+            flagged = true;
+        }
+    }
+    window.entries.push_back({day, amount});
+    window.quantiles.insert(amount);
+    return flagged;
 }
 
-bool validateDateFormat(const string &date)
+void RollingEditWindows::reset(const Ledger &ledger)
 {
-    regex datePattern(R"(\d{4}-\d{2}-\d{2})");
-    return regex_match(date, datePattern);
+    version = ledger.version;
+    window = ledger.rolling.window;
+    windows.clear();
 }
 
-void displayExpenses()
+// Keeps a cached window in step with one cell edit when the day falls inside it.
+void RollingEditWindows::update(int card, int category, int day, int oldValue, int newValue)
 {
-    bool hasData = false;
-    cout << "\n------------------------------------------------------------------------\n";
-    cout << "|    Date    |  Food  |  Work  |  Travel  |  Snacks  |  Fun  |  Extra  |\n";
-    cout << "------------------------------------------------------------------------\n";
-    for (int month = 0; month < 12; month++)
+    auto it = windows.find({card, category});
+    if (it == windows.end() || day >= it->second.end || day <= it->second.end - window)
+        return;
+    WindowQuantiles &quantiles = it->second.quantiles;
+    if (oldValue > 0)
+        quantiles.erase(oldValue);
+    if (newValue > 0)
+        quantiles.insert(newValue);
+}
+
+// Each (card, category) window covers the days [end - window + 1, end) and stays where the last
+// edit left it. Moving it to another day slides it one day at a time, an insert and an erase
+// of O(log w) each, so repeated edits around the same dates never rescan the window; only a
+// jump of a whole window or more rebuilds it from the column.
+const WindowQuantiles &RollingEditWindows::slide(const Ledger &ledger, int card, int category, int day)
+{
+    RollingEditWindow &entry = windows[{card, category}];
+    const int *column = ledger.amountColumn(category);
+    const int *cardIds = ledger.cardColumn(category);
+    auto add = [&](int d)
     {
-        for (int day = 0; day < 31; day++)
-        {
-            bool hasExpense = false;
-            for (int val : expenseData[month][day].first)
-            {
-                if (val > 0)
-                {
-                    hasExpense = true;
-                    break;
-                }
-            }
-            for (int val : expenseData[month][day].second)
-            {
-                if (val > 0)
-                {
-                    hasExpense = true;
-                    break;
-                }
-            }
-            if (!hasExpense)
-                continue;
-            hasData = true;
-            cout << "| 2024-"
-                 << (month + 1 < 10 ? "0" : "") << month + 1 << "-"
-                 << (day + 1 < 10 ? "0" : "") << day + 1 << " | ";
-            cout << right << setw(6) << expenseData[month][day].first[0] << " | ";
-            cout << right << setw(6) << expenseData[month][day].first[1] << " | ";
-            cout << right << setw(8) << expenseData[month][day].first[2] << " | ";
-            cout << right << setw(7) << expenseData[month][day].second[0] << "  | ";
-            cout << right << setw(5) << expenseData[month][day].second[1] << " | ";
-            cout << right << setw(7) << expenseData[month][day].second[2] << " | ";
-            cout << "\n";
-        }
+        if (d >= 0 && column[d] > 0 && cardIds[d] == card)
+            entry.quantiles.insert(column[d]);
+    };
+    auto remove = [&](int d)
+    {
+        if (d >= 0 && column[d] > 0 && cardIds[d] == card)
+            entry.quantiles.erase(column[d]);
+    };
+    if (abs(day - entry.end) >= window)
+    {
+        entry.quantiles = WindowQuantiles();
+        for (int d = day - window + 1; d < day; d++)
+            add(d);
+        entry.end = day;
     }
-    if (!hasData)
+    for (; entry.end < day; entry.end++)
     {
-        cout << "No expenses recorded." << endl;
+        add(entry.end);
+        remove(entry.end - window + 1);
+    }
+    while (entry.end > day)
+    {
+        entry.end--;
+        remove(entry.end);
+        add(entry.end - window + 1);
     }
-    cout << "------------------------------------------------------------------------\n";
-    Sleep(500);
+    return entry.quantiles;
 }
 
-void addExpense()
+vector<long long> Ledger::dayTotals() const
 {
-    string date;
-    cout << "Enter the date (YYYY-MM-DD): ";
-    cin >> date;
-    if (!validateDateFormat(date))
+    vector<long long> totals(dayCount(), 0);
+    for (int c = 0; c < categoryCount; c++)
     {
-        cout << "Invalid date format! Please enter in YYYY-MM-DD format.\n";
-        return;
+        const int *column = amountColumn(c);
+        for (int d = 0; d < dayCount(); d++)
+            totals[d] += column[d];
     }
-    int month, day;
-    try
+    return totals;
+}
+
+string Ledger::dateString(int day) const
+{
+    return dateOf(day).toString();
+}
+
+void pauseFor(int milliseconds)
+{
+    if (!headlessMode)
+        Sleep(milliseconds);
+}
+
+CategoryStats statisticsFromSums(long long count, double pivot, double sum, double sumSquares)
+{
+    CategoryStats stats;
+    stats.count = count;
+    if (count > 0)
     {
-        month = stoi(date.substr(5, 2)) - 1;
-        day = stoi(date.substr(8, 2)) - 1;
+        stats.mean = pivot + sum / count;
+        stats.m2 = max(0.0, sumSquares - sum * sum / count);
     }
-    catch (...)
+    return stats;
+}
+
+CategoryStats columnStatisticsScalar(const int *column, int count)
+{
+    int first = 0;
+    while (first < count && column[first] <= 0)
+        first++;
+    if (first == count)
+        return CategoryStats();
+    int pivot = column[first];
+    long long positives = 0;
+    double sum = 0, sumSquares = 0;
+    for (int d = first; d < count; d++)
     {
-        cout << "Date parsing failed. Please ensure it's numeric and in YYYY-MM-DD format.\n";
-        return;
+        if (column[d] > 0)
+        {
+            double x = column[d] - pivot;
+            positives++;
+            sum += x;
+            sumSquares += x * x;
+        }
+    }
+    return statisticsFromSums(positives, pivot, sum, sumSquares);
+}
+
+void scanAboveThresholdScalar(const int *column, int count, int threshold, vector<int> &hits)
+{
+    for (int d = 0; d < count; d++)
+    {
+        if (column[d] > threshold)
+            hits.push_back(d);
     }
-    int year = stoi(date.substr(0, 4));
-    if (!isValidDate(year, month + 1, day + 1))
+}
+
+#ifdef APS_X86_SIMD
+CategoryStats columnStatisticsSSE2(const int *column, int count)
+{
+    int first = 0;
+    while (first < count && column[first] <= 0)
+        first++;
+    if (first == count)
+        return CategoryStats();
+    int pivot = column[first];
+    const __m128i zero = _mm_setzero_si128(), pivots = _mm_set1_epi32(pivot);
+    __m128d sum = _mm_setzero_pd(), sumSquares = _mm_setzero_pd();
+    long long positives = 0;
+    int d = first;
+    for (; d + 4 <= count; d += 4)
     {
-        cout << "Invalid date! Please enter a real calendar date.\n";
-        return;
+        __m128i v = _mm_loadu_si128((const __m128i *)(column + d));
+        __m128i positive = _mm_cmpgt_epi32(v, zero);
+        __m128i shifted = _mm_and_si128(_mm_sub_epi32(v, pivots), positive);
+        __m128d low = _mm_cvtepi32_pd(shifted), high = _mm_cvtepi32_pd(_mm_shuffle_epi32(shifted, _MM_SHUFFLE(1, 0, 3, 2)));
+        sum = _mm_add_pd(sum, _mm_add_pd(low, high));
+        sumSquares = _mm_add_pd(sumSquares, _mm_add_pd(_mm_mul_pd(low, low), _mm_mul_pd(high, high)));
+        positives += bitset<4>(_mm_movemask_ps(_mm_castsi128_ps(positive))).count();
     }
-    bool dateExists = false;
-    for (int val : expenseData[month][day].first)
+    double lanes[2], squareLanes[2];
+    _mm_storeu_pd(lanes, sum);
+    _mm_storeu_pd(squareLanes, sumSquares);
+    double total = lanes[0] + lanes[1], totalSquares = squareLanes[0] + squareLanes[1];
+    for (; d < count; d++)
     {
-        if (val != 0)
+        if (column[d] > 0)
         {
-            dateExists = true;
-            break;
+            double x = column[d] - pivot;
+            positives++;
+            total += x;
+            totalSquares += x * x;
         }
     }
-    if (!dateExists)
+    return statisticsFromSums(positives, pivot, total, totalSquares);
+}
+
+void scanAboveThresholdSSE2(const int *column, int count, int threshold, vector<int> &hits)
+{
+    const __m128i thresholds = _mm_set1_epi32(threshold);
+    int d = 0;
+    for (; d + 4 <= count; d += 4)
     {
-        for (int val : expenseData[month][day].second)
+        __m128i v = _mm_loadu_si128((const __m128i *)(column + d));
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(v, thresholds)));
+        for (int lane = 0; mask != 0; lane++, mask >>= 1)
         {
-            if (val != 0)
-            {
-                dateExists = true;
-                break;
-            }
+            if (mask & 1)
+                hits.push_back(d + lane);
         }
     }
-    if (dateExists)
+    for (; d < count; d++)
     {
-        cout << "Error: An expense entry already exists for this date!\n";
-        return;
+        if (column[d] > threshold)
+            hits.push_back(d);
     }
-    if (month < 0 || month >= 12 || day < 0 || day >= 31)
+}
+
+APS_TARGET_AVX2 CategoryStats columnStatisticsAVX2(const int *column, int count)
+{
+    int first = 0;
+    while (first < count && column[first] <= 0)
+        first++;
+    if (first == count)
+        return CategoryStats();
+    int pivot = column[first];
+    const __m256i zero = _mm256_setzero_si256(), pivots = _mm256_set1_epi32(pivot);
+    __m256d sum = _mm256_setzero_pd(), sumSquares = _mm256_setzero_pd();
+    long long positives = 0;
+    int d = first;
+    for (; d + 8 <= count; d += 8)
     {
-        cout << "Invalid date! Month or day out of range.\n";
-        return;
+        __m256i v = _mm256_loadu_si256((const __m256i *)(column + d));
+        __m256i positive = _mm256_cmpgt_epi32(v, zero);
+        __m256i shifted = _mm256_and_si256(_mm256_sub_epi32(v, pivots), positive);
+        __m256d low = _mm256_cvtepi32_pd(_mm256_castsi256_si128(shifted)), high = _mm256_cvtepi32_pd(_mm256_extracti128_si256(shifted, 1));
+        sum = _mm256_add_pd(sum, _mm256_add_pd(low, high));
+        sumSquares = _mm256_add_pd(sumSquares, _mm256_add_pd(_mm256_mul_pd(low, low), _mm256_mul_pd(high, high)));
+        positives += bitset<8>(_mm256_movemask_ps(_mm256_castsi256_ps(positive))).count();
     }
-    map<string, double> expenseEntry;
-    map<string, int> cards;
-    for (const auto &category : essentialCategories)
+    double lanes[4], squareLanes[4];
+    _mm256_storeu_pd(lanes, sum);
+    _mm256_storeu_pd(squareLanes, sumSquares);
+    double total = lanes[0] + lanes[1] + lanes[2] + lanes[3], totalSquares = squareLanes[0] + squareLanes[1] + squareLanes[2] + squareLanes[3];
+    for (; d < count; d++)
     {
-        double amount;
-        int c_id;
-        cout << "Enter amount " << category << ": ";
-        if (!isValidDoubleInput(amount))
+        if (column[d] > 0)
         {
-            cout << "Invalid amount entered! Please enter a non-negative number.\n";
-            return;
+            double x = column[d] - pivot;
+            positives++;
+            total += x;
+            totalSquares += x * x;
         }
-        if (amount > 0)
+    }
+    return statisticsFromSums(positives, pivot, total, totalSquares);
+}
+
+APS_TARGET_AVX2 void scanAboveThresholdAVX2(const int *column, int count, int threshold, vector<int> &hits)
+{
+    const __m256i thresholds = _mm256_set1_epi32(threshold);
+    int d = 0;
+    for (; d + 8 <= count; d += 8)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(column + d));
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(v, thresholds)));
+        for (int lane = 0; mask != 0; lane++, mask >>= 1)
         {
-            while (true)
-            {
-                cout << "Choose the card ID you used for the payment:\n";
-                cout << "1 -> A\n2 -> B\n3 -> C\n4 -> None\n";
-                cout << "Enter choice: ";
-                if (!isValidIntInput(c_id))
-                {
-                    cout << "Invalid input! Please enter a number between 1 and 4.\n";
-                    return;
-                }
-                if (c_id >= 1 && c_id <= 3)
-                {
-                    break;
-                }
-                else if (c_id == 4)
-                {
-                    c_id = 0;
-                    break;
-                }
-                else
-                {
-                    cout << "Wrong choice! Valid options: 1-4.\n";
-                }
-            }
-        }
-        else
-        {
-            c_id = 0;
+            if (mask & 1)
+                hits.push_back(d + lane);
         }
-        expenseEntry[category] = amount;
-        cards[category] = c_id;
     }
-    for (const auto &category : nonEssentialCategories)
+    for (; d < count; d++)
     {
-        double amount;
-        int c_id;
-        cout << "Enter amount " << category << ": ";
-        if (!isValidDoubleInput(amount))
+        if (column[d] > threshold)
+            hits.push_back(d);
+    }
+}
+
+bool cpuSupportsAVX2()
+{
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+    __cpuid(info, 1);
+    bool osxsave = info[2] & (1 << 27), avx = info[2] & (1 << 28);
+    __cpuidex(info, 7, 0);
+    bool avx2 = info[1] & (1 << 5);
+    return osxsave && avx && avx2 && (_xgetbv(0) & 6) == 6;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+
+vector<AnomalyKernel> availableAnomalyKernels()
+{
+    vector<AnomalyKernel> kernels = {{"scalar", columnStatisticsScalar, scanAboveThresholdScalar}};
+#ifdef APS_X86_SIMD
+    kernels.push_back({"sse2", columnStatisticsSSE2, scanAboveThresholdSSE2});
+    if (cpuSupportsAVX2())
+        kernels.push_back({"avx2", columnStatisticsAVX2, scanAboveThresholdAVX2});
+#endif
+    return kernels;
+}
+
+AnomalyKernel &anomalyKernel()
+{
+    static AnomalyKernel kernel = availableAnomalyKernels().back();
+    return kernel;
+}
+
+bool selectAnomalyKernel(const string &name)
+{
+    for (const AnomalyKernel &kernel : availableAnomalyKernels())
+    {
+        if (kernel.name == name)
         {
-            cout << "Invalid amount entered! Please enter a non-negative number.\n";
-            return;
+            anomalyKernel() = kernel;
+            return true;
         }
-        if (amount > 0)
+    }
+    return false;
+}
+
+bool FraudAlertRing::push(const FraudAlert &alert)
+{
+    size_t back = tail.load(memory_order_relaxed);
+    if (back - head.load(memory_order_acquire) == slots.size())
+    {
+        dropped.fetch_add(1, memory_order_relaxed);
+        return false;
+    }
+    slots[back % slots.size()] = alert;
+    tail.store(back + 1, memory_order_release);
+    return true;
+}
+bool FraudAlertRing::pop(FraudAlert &alert)
+{
+    size_t front = head.load(memory_order_relaxed);
+    if (front == tail.load(memory_order_acquire))
+        return false;
+    alert = slots[front % slots.size()];
+    head.store(front + 1, memory_order_release);
+    return true;
+}
+
+// Callbacks run on the detecting thread; rings never block it and count what they drop when full.
+void FraudAlertStream::publish(const FraudAlert &alert) const
+{
+    for (const auto &callback : callbacks)
+        callback(alert);
+    for (FraudAlertRing *ring : rings)
+        ring->push(alert);
+}
+
+void FraudAlertConsumer::start(FraudAlertStream &source, function<void(const FraudAlert &)> handle)
+{
+    stop();
+    stream = &source;
+    stopping = false;
+    stream->rings.push_back(&ring);
+    worker = thread([this, handle]()
+                    {
+        FraudAlert alert;
+        int idle = 0;
+        while (true)
         {
-            while (true)
+            if (ring.pop(alert))
             {
-                cout << "Choose the card ID you used for the payment:\n";
-                cout << "1 -> A\n2 -> B\n3 -> C\n4 -> None\n";
-                cout << "Enter choice: ";
-                if (!isValidIntInput(c_id))
-                {
-                    cout << "Invalid input! Please enter a number between 1 and 4.\n";
-                    return;
-                }
-                if (c_id >= 1 && c_id <= 3)
-                {
-                    break;
-                }
-                else if (c_id == 4)
-                {
-                    c_id = 0;
-                    break;
-                }
-                else
-                {
-                    cout << "Wrong choice, try again.\n";
-                }
+                handle(alert);
+                idle = 0;
             }
+            else if (stopping.load(memory_order_acquire))
+                break;
+            else if (++idle < 64)
+                this_thread::yield();
+            else
+                this_thread::sleep_for(chrono::milliseconds(1));
         }
-        else
-        {
-            c_id = 0;
-        }
-        expenseEntry[category] = amount;
-        cards[category] = c_id;
-    }
-    for (size_t i = 0; i < essentialCategories.size(); ++i)
+        while (ring.pop(alert))
+            handle(alert); });
+}
+void FraudAlertConsumer::stop()
+{
+    if (!worker.joinable())
+        return;
+    stream->rings.erase(remove(stream->rings.begin(), stream->rings.end(), &ring), stream->rings.end());
+    stopping.store(true, memory_order_release);
+    worker.join();
+}
+
+void publishThresholdAlerts(const Ledger &ledger, const FraudAlertStream &stream)
+{
+    int dayCount = ledger.dayCount();
+    const AnomalyKernel &kernel = anomalyKernel();
+    vector<int> hits;
+    for (int c = 0; c < ledger.categoryCount; c++)
     {
-        expenseData[month][day].first[i] += expenseEntry[essentialCategories[i]];
-        cardid[month][day].first[i] = ((cards[essentialCategories[i]]));
+        if (!ledger.essential[c])
+            continue;
+        double threshold = ledger.stats[c].threshold();
+        if (threshold >= numeric_limits<int>::max())
+            continue;
+        const int *column = ledger.amountColumn(c);
+        hits.clear();
+        kernel.scan(column, dayCount, (int)floor(max(threshold, (double)numeric_limits<int>::min())), hits);
+        for (int d : hits)
+            stream.publish(ledger.thresholdAlert(c, d, column[d]));
     }
-    for (size_t i = 0; i < nonEssentialCategories.size(); ++i)
+}
+
+void publishRollingAlerts(const Ledger &ledger, const RollingDetectorOptions &options, const FraudAlertStream &stream)
+{
+    if (options.window <= 0)
+        return;
+    int dayCount = ledger.dayCount();
+    FraudAlert alert;
+    for (int c = 0; c < ledger.categoryCount; c++)
     {
-        expenseData[month][day].second[i] += expenseEntry[nonEssentialCategories[i]];
-        cardid[month][day].second[i] = ((cards[nonEssentialCategories[i]]));
+        RollingWindowDetector detector;
+        detector.options = options;
+        const int *column = ledger.amountColumn(c);
+        const int *cardIds = ledger.cardColumn(c);
+        for (int d = 0; d < dayCount; d++)
+        {
+            if (column[d] > 0 && detector.observe(d, c, cardIds[d], column[d], alert))
+                stream.publish(alert);
+        }
     }
-    ofstream file("OctExpenses.csv", ios::app);
-    if (file.is_open())
+}
+
+vector<FraudAlert> findFraudulentTransactions(const Ledger &ledger)
+{
+    vector<FraudAlert> flagged;
+    FraudAlertStream collector;
+    collector.callbacks.push_back([&](const FraudAlert &alert)
+                                  { flagged.push_back(alert); });
+    publishThresholdAlerts(ledger, collector);
+    stable_sort(flagged.begin(), flagged.end(), [](const FraudAlert &a, const FraudAlert &b)
+                { return a.day < b.day; });
+    return flagged;
+}
+
+vector<FraudAlert> findRollingAnomalies(const Ledger &ledger, const RollingDetectorOptions &options)
+{
+    vector<FraudAlert> flagged;
+    FraudAlertStream collector;
+    collector.callbacks.push_back([&](const FraudAlert &alert)
+                                  { flagged.push_back(alert); });
+    publishRollingAlerts(ledger, options, collector);
+    stable_sort(flagged.begin(), flagged.end(), [](const FraudAlert &a, const FraudAlert &b)
+                { return a.day < b.day; });
+    return flagged;
+}
+
+void detectFraudulentTransactions()
+{
+    vector<FraudAlert> table;
+    FraudAlertStream stream;
+    stream.callbacks.push_back([&](const FraudAlert &alert)
+                               { table.push_back(alert); });
+    publishThresholdAlerts(ledger, stream);
+    publishRollingAlerts(ledger, ledger.rolling, stream);
+    printFraudAlertTable(table);
+}
+
+void printFraudAlertTable(vector<FraudAlert> alerts)
+{
+    if (alerts.empty())
+        return;
+    stable_sort(alerts.begin(), alerts.end(), [](const FraudAlert &a, const FraudAlert &b)
+                { return (a.window > 0) != (b.window > 0) ? b.window > 0 : a.day < b.day; });
+    auto rolling = find_if(alerts.begin(), alerts.end(), [](const FraudAlert &alert)
+                           { return alert.window > 0; });
+    stringstream output;
+    output << "\nDetecting Fraudulent Transactions...\n";
+    if (rolling != alerts.begin())
     {
-        file << "\n"
-             << date;
-        for (const auto &category : essentialCategories)
+        output << "\nFlagged Transactions:\n";
+        output << "-------------------------------------------------\n";
+        output << "|    Date    | Category |  Amount  |   Status   |\n";
+        output << "-------------------------------------------------\n";
+        for (auto entry = alerts.begin(); entry != rolling; ++entry)
         {
-            file << "," << expenseEntry[category];
+            output << "| " << ledger.dateString(entry->day) << " | "
+                   << left << setw(8) << categoryName(entry->category) << " | "
+                   << right << setw(8) << entry->amount << " | "
+                   << left << setw(10) << "Fraudulent" << " |\n";
         }
-        for (const auto &category : nonEssentialCategories)
+        output << "-------------------------------------------------\n";
+    }
+    if (rolling != alerts.end())
+    {
+        output << "\nCard Spikes (" << rolling->window << "-day window):\n";
+        output << "------------------------------------------------------------\n";
+        output << "|    Date    | Category | Card |  Amount  |     Limit      |\n";
+        output << "------------------------------------------------------------\n";
+        for (auto entry = rolling; entry != alerts.end(); ++entry)
         {
-            file << "," << expenseEntry[category];
+            output << "| " << ledger.dateString(entry->day) << " | "
+                   << left << setw(8) << categoryName(entry->category) << " | "
+                   << setw(4) << cardName(entry->card) << " | "
+                   << right << setw(8) << entry->amount << " | "
+                   << setw(14) << fixed << setprecision(2) << entry->threshold << " |\n";
         }
-        file.close();
-        cout << "Expense added successfully!\n";
+        output << "------------------------------------------------------------\n";
     }
+    cout << output.str();
+}
+
+void printFraudAlert(const FraudAlert &alert)
+{
+    cout << "Fraud alert: " << ledger.dateString(alert.day) << " " << categoryName(alert.category) << " Rs. " << alert.amount;
+    if (alert.window > 0)
+        cout << " on card " << cardName(alert.card) << " exceeds its " << alert.window << "-day threshold of Rs. ";
     else
+        cout << " exceeds the category threshold of Rs. ";
+    cout << fixed << setprecision(2) << alert.threshold << "\n";
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+}
+
+string fraudAlertJson(const Ledger &ledger, const FraudAlert &alert)
+{
+    stringstream json;
+    json << fixed << setprecision(3) << "{\"date\":\"" << ledger.dateString(alert.day) << "\",\"category\":" << jsonString(ledger.categoryNames[alert.category])
+         << ",\"card\":" << jsonString(cardName(alert.card)) << ",\"amount\":" << alert.amount << ",\"score\":" << alert.score
+         << ",\"threshold\":" << alert.threshold << ",\"detector\":\"" << (alert.window > 0 ? "card-window" : "category") << "\"}";
+    return json.str();
+}
+
+bool MappedFile::open(const string &filename)
+{
+    close();
+    file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                       FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize))
     {
-        cout << "Error opening file.\n";
+        close();
+        return false;
     }
-    file.close();
-    ofstream file1("carddetails.csv", ios::app);
-    if (file1.is_open())
+    size = (size_t)fileSize.QuadPart;
+    if (size == 0)
+        return true;
+    mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr)
     {
-        file1 << "\n"
-              << date;
-        for (const auto &category : essentialCategories)
-        {
-            file1 << "," << cards[category];
-        }
-        for (const auto &category : nonEssentialCategories)
-        {
-            file1 << "," << cards[category];
-        }
-        file1.close();
+        close();
+        return false;
     }
-    else
+    data = (const char *)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (data == nullptr)
     {
-        cout << "Error opening file.\n";
+        close();
+        return false;
     }
-    file1.close();
-    cout << "Summary:\n";
-    cout << "The function 'addExpense()' allows users to log daily essential and non-essential expenses by entering amounts and selecting the payment card used. "
-         << "It validates the date format, prevents duplicate entries, stores data in structured maps, updates a 2D vector, and appends the data to CSV files. "
-         << "This logic is comparable to LeetCode problems involving input validation, hashmap usage, and matrix data handling (e.g., Insert Delete GetRandom O(1)). "
-         << "It uses concepts from date parsing, maps, vectors, file handling, and error checking. Time complexity is roughly O(n), where n is the number of categories.\n\n";
+    return true;
 }
 
-void updateExpense()
+void MappedFile::close()
 {
-    string filename = "OctExpenses.csv";
-    string date, category;
-    double newAmount;
-    displayExpenses();
-    cout << "Enter the date (YYYY-MM-DD) to update the Expences: ";
-    cin >> date;
-    if (!validateDateFormat(date))
+    if (data != nullptr)
+        UnmapViewOfFile(data);
+    if (mapping != nullptr)
+        CloseHandle(mapping);
+    if (file != INVALID_HANDLE_VALUE)
+        CloseHandle(file);
+    data = nullptr;
+    mapping = nullptr;
+    file = INVALID_HANDLE_VALUE;
+    size = 0;
+}
+
+const char *nextLine(const char *p, const char *end, const char *&lineEnd)
+{
+    const char *eol = (const char *)memchr(p, '\n', end - p);
+    if (eol == nullptr)
+        eol = end;
+    lineEnd = eol;
+    if (lineEnd > p && lineEnd[-1] == '\r')
+        --lineEnd;
+    return eol < end ? eol + 1 : end;
+}
+
+bool parseIntField(const char *p, const char *end, int &value)
+{
+    while (p < end && (*p == ' ' || *p == '\t'))
+        ++p;
+    if (p < end && *p == '+')
+        ++p;
+    return from_chars(p, end, value).ec == errc();
+}
+
+vector<string> parseCSVHeader(const char *line, const char *lineEnd)
+{
+    vector<string> names;
+    const char *field = (const char *)memchr(line, ',', lineEnd - line);
+    while (field != nullptr && field < lineEnd)
     {
-        cout << "Invalid date format! Please enter in YYYY-MM-DD format.\n";
-        return;
+        field++;
+        const char *fieldEnd = (const char *)memchr(field, ',', lineEnd - field);
+        if (fieldEnd == nullptr)
+            fieldEnd = lineEnd;
+        const char *first = field, *last = fieldEnd;
+        while (first < last && isspace((unsigned char)*first))
+            first++;
+        while (last > first && isspace((unsigned char)last[-1]))
+            last--;
+        if (first < last)
+            names.emplace_back(first, last);
+        field = fieldEnd;
     }
-    int month = stoi(date.substr(5, 2)) - 1;
-    int day = stoi(date.substr(8, 2)) - 1;
-    if (month < 0 || month >= 12 || day < 0 || day >= 31)
+    return names;
+}
+
+void IngestDiagnostics::record(const char *text, const char *textEnd, size_t lineNumber, int column, int kind, bool cardFile)
+{
+    counts[cardFile][kind]++;
+    if (issues.size() < capacity)
+        issues.push_back({text, textEnd, (uint32_t)lineNumber, (uint16_t)column, (uint8_t)kind, (uint8_t)cardFile});
+    if (errorCount)
+        errorCount->fetch_add(1, memory_order_relaxed);
+}
+
+template <int FixedCategories>
+int parseLedgerRow(const char *line, const char *lineEnd, bool isCardFile, CSVChunk &chunk)
+{
+    const int categoryCount = FixedCategories > 0 ? FixedCategories : chunk.ledger.categoryCount;
+    size_t lineNumber = isCardFile ? chunk.cardRows : chunk.rows;
+    const char *comma = (const char *)memchr(line, ',', lineEnd - line);
+    const char *dateEnd = comma ? comma : lineEnd;
+    if (dateEnd - line != 10)
     {
-        cout << "Invalid date! Month or day out of range.\n";
-        return;
+        chunk.diagnostics.record(line, lineEnd, lineNumber, 1, INGEST_BAD_DATE_FORMAT, isCardFile);
+        return -1;
     }
-    if (expenseData.empty())
+    Date date;
+    int year = 0;
+    if (!Date::parse(line, 10, date) || (year = date.year()) < MIN_LEDGER_YEAR || year > MAX_LEDGER_YEAR)
     {
-        cout << "Error: No expense data loaded in memory.\n";
-        return;
+        chunk.diagnostics.record(line, lineEnd, lineNumber, 1, INGEST_BAD_DATE, isCardFile);
+        return -1;
     }
-    if (month < expenseData.size() && day < expenseData[month].size())
+    chunk.ledger.ensureYear(year);
+    int dayCount = chunk.ledger.dayCount();
+    int *cell = (isCardFile ? chunk.ledger.cards.data() : chunk.ledger.amounts.data()) + chunk.ledger.dayOf(date);
+    const char *field = comma ? comma + 1 : lineEnd;
+    for (int i = 0; i < categoryCount && field < lineEnd; i++)
     {
-        int choice;
-        cout << "Select a category to update:\n";
-        cout << "1 - Food\n";
-        cout << "2 - Work\n";
-        cout << "3 - Travel\n";
-        cout << "4 - Snacks\n";
-        cout << "5 - Fun\n";
-        cout << "6 - Extra\n";
-        cout << "Enter your choice (1-6): ";
-        if (!isValidIntInput(choice))
-        {
-            cout << "Invalid input! Please enter a number between 1 and 4.\n";
-            return;
-        }
-        if (choice < 1 || choice > 6)
-        {
-            cout << "Invalid choice! Please enter a number between 1 and 6.\n";
-            return;
-        }
-        switch (choice)
-        {
-        case 1:
-            category = "food";
-            break;
-        case 2:
-            category = "work";
-            break;
-        case 3:
-            category = "travel";
-            break;
-        case 4:
-            category = "snacks";
-            break;
-        case 5:
-            category = "fun";
-            break;
-        case 6:
-            category = "extra";
-            break;
-        default:
-            cout << "Invalid choice! Please enter a number between 1 and 6.\n";
-        }
-        cout << "Enter the new amount: ";
-        if (!isValidDoubleInput(newAmount))
-        {
-            cout << "Invalid amount entered! Please enter a non-negative number.\n";
-            return;
-        }
-        if (newAmount < 0)
-        {
-            cout << "Amount cannot be negative.\n";
-            return;
-        }
-        bool categoryFound = false;
-        for (auto &exp : expenseData[month][day].first)
-        {
-            if (essentialCategories[&exp - &expenseData[month][day].first[0]] == category)
-            {
-                exp = newAmount;
-                categoryFound = true;
-                break;
-            }
-        }
-        for (auto &exp : expenseData[month][day].second)
-        {
-            if (nonEssentialCategories[&exp - &expenseData[month][day].second[0]] == category)
-            {
-                exp = newAmount;
-                categoryFound = true;
-                break;
-            }
-        }
-        if (!categoryFound)
-        {
-            cout << "Category not found for the specified date!" << endl;
-            return;
-        }
-        cout << "Expense updated successfully in memory!" << endl;
-        ifstream inFile(filename);
-        if (!inFile.is_open())
-        {
-            cerr << "Error: Cannot open file " << filename << " for reading.\n";
-            return;
-        }
-        ofstream outFile("temp.csv");
-        if (!outFile.is_open())
-        {
-            cerr << "Error: Cannot open temporary file for writing.\n";
-            inFile.close();
-            return;
-        }
-        string line;
-        bool found = false;
-        if (getline(inFile, line))
+        const char *fieldEnd = (const char *)memchr(field, ',', lineEnd - field);
+        if (fieldEnd == nullptr)
+            fieldEnd = lineEnd;
+        int amount;
+        if (parseIntField(field, fieldEnd, amount))
         {
-            outFile << line << "\n";
-        }
-        while (getline(inFile, line))
-        {
-            stringstream ss(line);
-            string recordDate, recordCategory;
-            getline(ss, recordDate, ',');
-            getline(ss, recordCategory, ',');
-            if (recordDate == date)
-            {
-                found = true;
-                stringstream newLineStream;
-                newLineStream << recordDate;
-                for (const auto &category : essentialCategories)
-                {
-                    newLineStream << "," << expenseData[month][day].first[&category - &essentialCategories[0]];
-                }
-                for (const auto &category : nonEssentialCategories)
-                {
-                    newLineStream << "," << expenseData[month][day].second[&category - &nonEssentialCategories[0]];
-                }
-                outFile << newLineStream.str();
-            }
-            else
+            // Repeated dates add up their amounts, but a cell is paid with one card: a later
+            // nonzero card id replaces the earlier one rather than adding to it.
+            int &target = cell[(size_t)i * dayCount];
+            if (!isCardFile)
             {
-                outFile << line;
+                chunk.ledger.stats[i].replace(target, target + amount);
+                target += amount;
             }
-            outFile << "\n";
-        }
-        inFile.close();
-        outFile.close();
-        if (found)
-        {
-            remove(filename.c_str());
-            rename("temp.csv", filename.c_str());
-            cout << "Expense for date " << date << " has been updated successfully.\n";
+            else if (amount != 0)
+                target = amount;
         }
         else
         {
-            remove("temp.csv");
-            cout << "Expense not found for the entered date.\n";
+            chunk.diagnostics.record(line, lineEnd, lineNumber, i + 2, INGEST_BAD_AMOUNT, isCardFile);
         }
+        field = fieldEnd < lineEnd ? fieldEnd + 1 : lineEnd;
     }
-    else
-    {
-        cout << "Expense not found in the data structure!" << endl;
-    }
-    displayExpenses();
-    cout << "Summary:\n";
-    cout << "The function 'updateExpense' allows a user to update a specific category of daily expenses for a given date, validating inputs and modifying both in-memory and CSV-stored data accordingly. "
-         << "It combines file I/O handling, data structure traversal, and user input validation. "
-         << "This approach is similar to LeetCode problems like 'Edit Distance in a Matrix' where data updates must maintain consistency. "
-         << "Key topics include file handling, 2D vector manipulation, string parsing, and input validation, with an overall time complexity of O(n) where n is the number of lines in the CSV file.\n\n";
+    return date - Date::fromCivil(MIN_LEDGER_YEAR, 1, 1);
 }
 
-bool deleteExpenses(string &filename, string &date)
+// The two files are joined on date rather than by position: each side is parsed on its own
+// and only counts its rows per date, and importLedger reports the dates one side lacks.
+template <int FixedCategories>
+void parseCSVChunk(const char *expense, const char *expenseEnd, const char *card, const char *cardEnd, CSVChunk &chunk)
 {
-    int month, day;
-    try
+    const char *lineEnd;
+    while (expense < expenseEnd && !chunk.diagnostics.overBudget())
     {
-        month = stoi(date.substr(5, 2)) - 1;
-        day = stoi(date.substr(8, 2)) - 1;
-        if (month < 0 || month >= 12 || day < 0 || day >= 31)
-        {
-            cerr << "Invalid date! Month or day out of range.\n";
-            return false;
-        }
+        const char *line = expense;
+        expense = nextLine(expense, expenseEnd, lineEnd);
+        chunk.rows++;
+        int date = parseLedgerRow<FixedCategories>(line, lineEnd, false, chunk);
+        if (chunk.joined && date >= 0)
+            chunk.dateRows[date].first++;
     }
-    catch (const invalid_argument &e)
+    while (card < cardEnd && !chunk.diagnostics.overBudget())
     {
-        cerr << "Error: Invalid number in date. " << e.what() << "\n";
-        return false;
+        const char *line = card;
+        card = nextLine(card, cardEnd, lineEnd);
+        chunk.cardRows++;
+        int date = parseLedgerRow<FixedCategories>(line, lineEnd, true, chunk);
+        if (date >= 0)
+            chunk.dateRows[date].second++;
     }
-    catch (const out_of_range &e)
+}
+
+vector<const char *> splitCSVChunks(const char *p, const char *end, size_t chunkCount)
+{
+    const char *lineEnd;
+    vector<const char *> bounds(chunkCount + 1, end);
+    bounds[0] = p;
+    for (size_t k = 1; k < chunkCount; k++)
     {
-        cerr << "Error: Date values out of range. " << e.what() << "\n";
-        return false;
+        const char *split = max(bounds[k - 1], p + (end - p) * k / chunkCount);
+        bounds[k] = split > p && split < end && split[-1] != '\n' ? nextLine(split, end, lineEnd) : split;
     }
-    expenseData[month][day].first = {0, 0, 0};
-    expenseData[month][day].second = {0, 0, 0};
-    cardid[month][day].first = {0, 0, 0};
-    cardid[month][day].second = {0, 0, 0};
-    ifstream inFile(filename);
-    if (!inFile.is_open())
+    return bounds;
+}
+
+const char *alignCSVChunk(const char *expenseLine, const char *expenseEnd, const char *cardBegin, const char *cardEnd, const char *guess)
+{
+    const char *lineEnd;
+    if (expenseLine >= expenseEnd)
+        return cardEnd;
+    nextLine(expenseLine, expenseEnd, lineEnd);
+    const char *comma = (const char *)memchr(expenseLine, ',', lineEnd - expenseLine);
+    size_t dateLength = (comma ? comma : lineEnd) - expenseLine;
+    const char *forward = guess;
+    const char *backward = guess;
+    for (int step = 0; step < 1024; step++)
     {
-        cerr << "Error: Cannot open file " << filename << " for reading.\n";
-        return false;
+        if (forward < cardEnd)
+        {
+            if ((size_t)(cardEnd - forward) > dateLength && memcmp(forward, expenseLine, dateLength) == 0 && forward[dateLength] == ',')
+                return forward;
+            forward = nextLine(forward, cardEnd, lineEnd);
+        }
+        if (backward > cardBegin)
+        {
+            const char *previous = backward - 1;
+            while (previous > cardBegin && previous[-1] != '\n')
+                --previous;
+            backward = previous;
+            if ((size_t)(cardEnd - backward) > dateLength && memcmp(backward, expenseLine, dateLength) == 0 && backward[dateLength] == ',')
+                return backward;
+        }
     }
-    ofstream outFile("temp.csv");
-    if (!outFile.is_open())
+    return guess;
+}
+
+bool importLedger(const string &expenseFile, const string &cardFile, Ledger &ledger, int threadCount, const IngestOptions &options, LedgerImport &import)
+{
+    auto start = chrono::steady_clock::now();
+    MappedFile &expenses = import.expenses, &cards = import.cards;
+    if (!expenses.open(expenseFile))
     {
-        cerr << "Error: Cannot open temporary file for writing.\n";
-        inFile.close();
+        import.error = "Cannot open file " + expenseFile;
         return false;
     }
-    string line;
-    bool found = false;
-    bool isFirstLine = true;
-    if (getline(inFile, line))
+    bool joined = !cardFile.empty();
+    if (joined && !cards.open(cardFile))
     {
-        outFile << line << "\n";
+        import.error = "Cannot open file " + cardFile;
+        return false;
     }
-    while (getline(inFile, line))
+    const char *lineEnd;
+    const char *expenseBegin = expenses.data, *expenseEnd = expenses.data + expenses.size;
+    const char *cardBegin = cards.data, *cardEnd = cards.data + cards.size;
+    vector<string> header = defaultCategories;
+    if (expenseBegin < expenseEnd)
     {
-        stringstream ss(line);
-        string recordDate;
-        if (!getline(ss, recordDate, ','))
-        {
-            cerr << "Warning: Skipping malformed line.\n";
-            continue;
-        }
-        if (recordDate == date)
-        {
-            found = true;
-            continue;
-        }
-        if (!isFirstLine)
+        const char *line = expenseBegin;
+        expenseBegin = nextLine(expenseBegin, expenseEnd, lineEnd);
+        header = parseCSVHeader(line, lineEnd);
+        if (header.empty())
         {
-            outFile << "\n";
+            import.error = "No expense categories in the header of " + expenseFile;
+            return false;
         }
-        outFile << line;
-        isFirstLine = false;
     }
-    inFile.close();
-    outFile.close();
-    if (found)
+    if (ledger.categoryCount == 0)
+    {
+        ledger.setCategories(header, loadCategoryConfig(categoryConfigFilename));
+    }
+    else if (ledger.categoryNames != header)
+    {
+        import.error = "The categories in " + expenseFile + " do not match the loaded ledger.";
+        return false;
+    }
+    if (cardBegin < cardEnd)
+    {
+        const char *line = cardBegin;
+        cardBegin = nextLine(cardBegin, cardEnd, lineEnd);
+        if (parseCSVHeader(line, lineEnd) != header)
+            import.warnings.push_back("The header of " + cardFile + " does not match " + expenseFile + "; card columns are read in expense-header order.");
+    }
+    size_t minChunkBytes = 1 << 20;
+    size_t chunkCount = max<size_t>(1, min<size_t>(max(threadCount, 1), (expenseEnd - expenseBegin) / minChunkBytes));
+    vector<const char *> expenseBounds = splitCSVChunks(expenseBegin, expenseEnd, chunkCount);
+    vector<const char *> cardBounds = splitCSVChunks(cardBegin, cardEnd, chunkCount);
+    for (size_t k = 1; k < chunkCount; k++)
+    {
+        const char *aligned = alignCSVChunk(expenseBounds[k], expenseEnd, cardBegin, cardEnd, cardBounds[k]);
+        cardBounds[k] = max(cardBounds[k - 1], aligned);
+    }
+    vector<CSVChunk> chunks(chunkCount);
+    atomic<size_t> errorCount(0);
+    for (CSVChunk &chunk : chunks)
+    {
+        chunk.ledger.categoryCount = ledger.categoryCount;
+        chunk.ledger.stats.assign(ledger.categoryCount, CategoryStats());
+        chunk.joined = joined;
+        chunk.diagnostics.capacity = options.capacity;
+        chunk.diagnostics.issues.reserve(options.capacity);
+        chunk.diagnostics.errorCount = &errorCount;
+        chunk.diagnostics.errorBudget = options.errorBudget;
+    }
+    auto chunkParser = ledger.categoryCount == FIXED_CATEGORY_COUNT ? parseCSVChunk<FIXED_CATEGORY_COUNT> : parseCSVChunk<0>;
+    if (chunkCount == 1)
+    {
+        chunkParser(expenseBounds[0], expenseBounds[1], cardBounds[0], cardBounds[1], chunks[0]);
+    }
+    else
     {
-        if (remove(filename.c_str()) != 0)
+        vector<thread> workers;
+        for (size_t k = 0; k < chunkCount; k++)
+            workers.emplace_back(chunkParser, expenseBounds[k], expenseBounds[k + 1], cardBounds[k], cardBounds[k + 1], ref(chunks[k]));
+        for (thread &worker : workers)
+            worker.join();
+    }
+    bool stopped = errorCount > options.errorBudget;
+    auto countLines = [](const char *p, const char *end)
+    {
+        size_t lines = 0;
+        const char *lineEnd;
+        for (; p < end; lines++)
+            p = nextLine(p, end, lineEnd);
+        return lines;
+    };
+    size_t rows = 0, cardRows = 0;
+    IngestDiagnostics &diagnostics = import.diagnostics;
+    for (size_t k = 0; k < chunkCount; k++)
+    {
+        if (stopped)
         {
-            cerr << "Error: Could not delete original file.\n";
-            return false;
+            rows = k ? rows + countLines(expenseBounds[k - 1], expenseBounds[k]) : 0;
+            cardRows = k ? cardRows + countLines(cardBounds[k - 1], cardBounds[k]) : 0;
         }
-        if (rename("temp.csv", filename.c_str()) != 0)
+        const IngestDiagnostics &chunkDiagnostics = chunks[k].diagnostics;
+        // Chunk line numbers count data rows; the header adds one more line to each file.
+        for (IngestIssue issue : chunkDiagnostics.issues)
         {
-            cerr << "Error: Could not rename temp.csv to original file.\n";
-            return false;
+            issue.lineNumber += (issue.cardFile ? cardRows : rows) + 1;
+            diagnostics.issues.push_back(issue);
+        }
+        for (int file = 0; file < 2; file++)
+            for (int kind = 0; kind < INGEST_ERROR_KINDS; kind++)
+                diagnostics.counts[file][kind] += chunkDiagnostics.counts[file][kind];
+        if (!stopped)
+        {
+            rows += chunks[k].rows;
+            cardRows += chunks[k].cardRows;
         }
-        cout << "Expenses for " << date << " deleted successfully.\n";
-        return true;
     }
-    else
+    // Every chunk keeps its own first problems, so sorting before truncating keeps the same
+    // examples however the threads were scheduled.
+    stable_sort(diagnostics.issues.begin(), diagnostics.issues.end(), [](const IngestIssue &a, const IngestIssue &b)
+                { return a.cardFile != b.cardFile ? a.cardFile < b.cardFile : a.lineNumber < b.lineNumber; });
+    if (diagnostics.issues.size() > options.capacity)
+        diagnostics.issues.resize(options.capacity);
+    import.parsed = true;
+    import.rows = rows;
+    import.cardRows = cardRows;
+    import.chunkCount = chunkCount;
+    if (stopped)
     {
-        remove("temp.csv");
-        cerr << "No expenses found for date: " << date << ". Nothing deleted.\n";
+        import.error = "Import stopped after " + to_string(errorCount) + " problem(s); the error budget is " + to_string(options.errorBudget) + ".";
         return false;
     }
-}
-
-void menu(vector<int> &monthlyTotals);
-
-void optimizeSavingsPlan(vector<tuple<int, int, string>> &nonEssentialExpensesWithDates, int &goal)
-{
-    int n = nonEssentialExpensesWithDates.size();
-    vector<vector<int>> dp(n + 1, vector<int>(goal + 1, -1));
-    vector<vector<int>> count(n + 1, vector<int>(goal + 1, 1e9));
-    vector<vector<vector<tuple<int, int, string>>>> chosen(n + 1, vector<vector<tuple<int, int, string>>>(goal + 1));
-    dp[0][0] = 0;
-    count[0][0] = 0;
-    for (int i = 1; i <= n; i++)
+    map<int, pair<int, int>> dateRows;
+    for (const CSVChunk &chunk : chunks)
     {
-        int expense = get<0>(nonEssentialExpensesWithDates[i - 1]);
-        int date = get<1>(nonEssentialExpensesWithDates[i - 1]);
-        string category = get<2>(nonEssentialExpensesWithDates[i - 1]);
-        for (int j = 0; j <= goal; j++)
+        ledger.merge(chunk.ledger);
+        for (const auto &entry : chunk.dateRows)
         {
-            if (dp[i - 1][j] != -1)
-            {
-                dp[i][j] = dp[i - 1][j];
-                count[i][j] = count[i - 1][j];
-                chosen[i][j] = chosen[i - 1][j];
-            }
-            if (j >= expense && dp[i - 1][j - expense] != -1)
-            {
-                int newSum = dp[i - 1][j - expense] + expense;
-                int newCount = count[i - 1][j - expense] + 1;
-                if (dp[i][j] == -1 || (newSum > dp[i][j]) || (newSum == dp[i][j] && newCount < count[i][j]))
-                {
-                    dp[i][j] = newSum;
-                    count[i][j] = newCount;
-                    chosen[i][j] = chosen[i - 1][j - expense];
-                    chosen[i][j].push_back({expense, date, category});
-                }
-            }
+            dateRows[entry.first].first += entry.second.first;
+            dateRows[entry.first].second += entry.second.second;
         }
     }
-    int bestSavings = 0, minCount = 1e9;
-    vector<tuple<int, int, string>> bestSet;
-    for (int j = 0; j <= goal; j++)
+    for (const auto &entry : dateRows)
     {
-        if (dp[n][j] != -1)
-        {
-            if (dp[n][j] > bestSavings || (dp[n][j] == bestSavings && count[n][j] < minCount))
-            {
-                bestSavings = dp[n][j];
-                minCount = count[n][j];
-                bestSet = chosen[n][j];
-            }
-        }
-    }
-    cout << "\nTotal Savings Achieved: " << bestSavings
-         << " using " << minCount << " expense entries.\n";
-    cout << "-------------------------------------------------\n";
-    cout << "By reducing the following expenses, you can successfully meet your savings target upto " << bestSavings << "!\n";
-    cout << "-------------------------------------------------\n";
-    cout << "+-----------+---------------+-----------------+" << endl;
-    cout << left
-         << "| " << setw(10) << "Amount"
-         << "| " << setw(14) << "Date (MM-DD)"
-         << "| " << setw(16) << "Category"
-         << "|" << endl;
-    cout << "+-----------+---------------+-----------------+" << endl;
-    for (const auto &entry : bestSet)
-    {
-        int e, d;
-        string cat;
-        tie(e, d, cat) = entry;
-        int month = d / 100;
-        int day = d % 100;
-        stringstream dateStream;
-        dateStream << setfill('0') << setw(2) << month << "-" << setw(2) << day;
-        cout << left
-             << "| Rs. " << setw(6) << e
-             << "| " << setw(14) << dateStream.str()
-             << "| " << setw(16) << cat
-             << "|" << endl;
+        if (entry.second.first == 0 || entry.second.second == 0)
+            import.mismatches[entry.first] = entry.second.first - entry.second.second;
     }
-    cout << "+-----------+--------------+------------------+" << endl;
-    cout << endl;
+    import.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return true;
 }
-double optimizeSavings(int &goal)
+
+bool parseCSV(const string &expenseFile, const string &cardFile, Ledger &ledger, int threadCount, const IngestOptions &options)
 {
-    vector<tuple<int, int, string>> nonEssentialExpensesWithDates;
-    for (int month = 0; month < 12; ++month)
+    LedgerImport import;
+    bool imported = importLedger(expenseFile, cardFile, ledger, threadCount, options, import);
+    for (const string &warning : import.warnings)
+        cerr << "Warning: " << warning << endl;
+    if (import.parsed)
+        reportIngestDiagnostics(expenseFile, cardFile, import.diagnostics, options);
+    if (!imported)
     {
-        for (int day = 0; day < 31; ++day)
-        {
-            const vector<int> &nonEssential = expenseData[month][day].second;
-            int date = (month + 1) * 100 + (day + 1);
-            for (int i = 0; i < nonEssential.size(); ++i)
-            {
-                if (nonEssential[i] != 0)
-                {
-                    nonEssentialExpensesWithDates.push_back({nonEssential[i], date, nonEssentialCategories[i]});
-                }
-            }
-        }
+        cerr << "Error: " << import.error << endl;
+        return false;
     }
-    optimizeSavingsPlan(nonEssentialExpensesWithDates, goal);
-    return 0;
+    bool joined = !cardFile.empty();
+    size_t rows = import.rows, cardRows = import.cardRows, chunkCount = import.chunkCount;
+    double seconds = import.seconds;
+    double megabytes = (import.expenses.size + import.cards.size) / (1024.0 * 1024.0);
+    import.expenses.close();
+    import.cards.close();
+    pauseFor(2000);
+    cout << "Parsing CSV file...\n";
+    pauseFor(2000);
+    cout << "Parsing expenses details completed successfully!\n";
+    if (joined)
+        cout << "\nParsing card details completed successfully!\n";
+    cout << "Parsed " << rows << " expense rows and " << cardRows << " card rows (" << fixed << setprecision(2) << megabytes << " MB) in "
+         << seconds * 1000 << " ms on " << chunkCount << " thread(s): " << setprecision(0) << (seconds > 0 ? (rows + cardRows) / seconds : 0) << " rows/s, "
+         << setprecision(2) << (seconds > 0 ? megabytes / seconds : 0) << " MB/s\n";
+    cout.unsetf(ios::fixed);
+    cout << setprecision(6);
+    reportLedgerMismatches(expenseFile, cardFile, import.mismatches);
+    pauseFor(2000);
+    return true;
 }
 
-vector<PaymentResult> optimizeCreditCardPayments(const vector<vector<pair<vector<int>, vector<int>>>> &expenseData, const vector<vector<pair<vector<int>, vector<int>>>> &cardid,
-                                                 vector<CreditCard> &cardVec, int availableFunds)
+bool reportIngestDiagnostics(const string &expenseFile, const string &cardFile, const IngestDiagnostics &diagnostics, const IngestOptions &options)
 {
-    vector<int> totalDue(4, 0);
-    for (int month = 0; month < 12; ++month)
+    size_t fileTotals[2] = {}, kindTotals[INGEST_ERROR_KINDS] = {};
+    for (int file = 0; file < 2; file++)
     {
-        for (int day = 0; day < 31; ++day)
+        for (int kind = 0; kind < INGEST_ERROR_KINDS; kind++)
         {
-            auto expenses = expenseData[month][day];
-            auto cards = cardid[month][day];
-            for (int i = 0; i < 3; ++i)
-            {
-                int cardIdx = cards.first[i];
-                if (cardIdx >= 1 && cardIdx <= 3)
-                {
-                    totalDue[cardIdx] += expenses.first[i];
-                }
-            }
-            for (int i = 0; i < 3; ++i)
-            {
-                int cardIdx = cards.second[i];
-                if (cardIdx >= 1 && cardIdx <= 3)
-                {
-                    totalDue[cardIdx] += expenses.second[i];
-                }
-            }
+            fileTotals[file] += diagnostics.counts[file][kind];
+            kindTotals[kind] += diagnostics.counts[file][kind];
         }
     }
-    vector<int> amountPaid(4, 0);
-    for (int i = 1; i <= 3; ++i)
+    size_t total = fileTotals[0] + fileTotals[1];
+    if (total == 0)
+        return true;
+    const string *files[2] = {&expenseFile, &cardFile};
+    cerr << "Warning: " << fileTotals[0] << " problem(s) in " << expenseFile;
+    if (!cardFile.empty())
+        cerr << " and " << fileTotals[1] << " in " << cardFile;
+    const char *separator = ": ";
+    for (int kind = 0; kind < INGEST_ERROR_KINDS; kind++)
     {
-        int minDue = cardVec[i].minDue;
-        int pay = min(minDue, totalDue[i]);
-        if (availableFunds >= pay)
+        if (kindTotals[kind] > 0)
         {
-            amountPaid[i] += pay;
-            availableFunds -= pay;
+            cerr << separator << kindTotals[kind] << " " << ingestErrorNames[kind];
+            separator = ", ";
         }
     }
-    vector<pair<int, double>> sortedCards;
-    for (int i = 1; i <= 3; ++i)
+    cerr << "\n";
+    size_t shown = min<size_t>(diagnostics.issues.size(), INGEST_SUMMARY_EXAMPLES);
+    for (size_t i = 0; i < shown; i++)
     {
-        int unpaid = totalDue[i] - amountPaid[i];
-        if (unpaid > 0)
-        {
-            sortedCards.push_back(make_pair(i, cardVec[i].interestRate));
-        }
+        const IngestIssue &issue = diagnostics.issues[i];
+        cerr << "  " << *files[issue.cardFile] << " line " << issue.lineNumber << ", column " << issue.column << ": " << ingestErrorNames[issue.kind] << ": ";
+        cerr.write(issue.text, issue.textEnd - issue.text) << "\n";
     }
-    sort(sortedCards.begin(), sortedCards.end(), [](const pair<int, double> &a, const pair<int, double> &b)
-         { return a.second > b.second; });
-    for (size_t i = 0; i < sortedCards.size(); ++i)
+    if (total > shown)
+        cerr << "  ... and " << total - shown << " more" << (options.reportFile.empty() ? "" : "; see " + options.reportFile) << "\n";
+    if (options.reportFile.empty())
+        return true;
+    ofstream report(options.reportFile);
+    report << "file,line,column,kind,text\n";
+    for (const IngestIssue &issue : diagnostics.issues)
     {
-        int idx = sortedCards[i].first;
-        double rate = sortedCards[i].second;
-        int unpaid = totalDue[idx] - amountPaid[idx];
-        int pay = min(unpaid, availableFunds);
-        amountPaid[idx] += pay;
-        availableFunds -= pay;
-        if (availableFunds == 0)
-            break;
+        report << *files[issue.cardFile] << "," << issue.lineNumber << "," << issue.column << "," << ingestErrorNames[issue.kind] << ",\"";
+        for (const char *p = issue.text; p < issue.textEnd; p++)
+            report << (*p == '"' ? "\"\"" : string(1, *p));
+        report << "\"\n";
     }
-    vector<PaymentResult> results;
-    for (int i = 1; i <= 3; ++i)
+    if (total > diagnostics.issues.size())
+        report << "# " << total - diagnostics.issues.size() << " more problem(s) were counted but not recorded\n";
+    if (!report)
     {
-        int unpaid = totalDue[i] - amountPaid[i];
-        double interest = unpaid * cardVec[i].interestRate / 100.0;
-        results.push_back({cardVec[i].name, totalDue[i], amountPaid[i], unpaid, interest});
+        cerr << "Warning: Could not write diagnostics report " << options.reportFile << endl;
+        return false;
     }
-    sort(results.begin(), results.end(), [&](const PaymentResult &a, const PaymentResult &b)
-         {
-        int ai = a.card[0] - 'A' + 1;int bi = b.card[0] - 'A' + 1;
-        return cardVec[ai].interestRate > cardVec[bi].interestRate; });
-    return results;
+    return true;
 }
 
-void displayResults(const vector<PaymentResult> &results)
+void reportLedgerMismatches(const string &expenseFile, const string &cardFile, const map<int, int> &mismatches)
 {
-    cout << "+-----------+------------+-----------+-----------+-------------------+" << endl;
-    cout << left
-         << "| " << setw(10) << "Card"
-         << "| " << setw(11) << "Total Due"
-         << "| " << setw(10) << "Paid"
-         << "| " << setw(10) << "Unpaid"
-         << "| " << setw(18) << "Interest Incurred"
-         << "|" << endl;
-    cout << "+-----------+------------+-----------+-----------+-------------------+" << endl;
-    for (const auto &r : results)
+    vector<pair<int, int>> dates;
+    for (const auto &entry : mismatches)
     {
-        cout << left
-             << "| " << setw(10) << r.card
-             << "| " << setw(11) << fixed << setprecision(2) << r.totalDue
-             << "| " << setw(10) << r.amountPaid
-             << "| " << setw(10) << r.unpaidAmount
-             << "| " << setw(18) << ("Rs. " + to_string(r.interest))
-             << "|" << endl;
+        if (entry.second != 0)
+            dates.push_back(entry);
     }
-    cout << "+-----------+------------+-----------+-----------+-------------------+" << endl;
+    if (dates.empty())
+        return;
+    cerr << "Warning: " << expenseFile << " and " << cardFile << " disagree on " << dates.size() << " date(s):\n";
+    size_t shown = min<size_t>(dates.size(), 20);
+    for (size_t i = 0; i < shown; i++)
+    {
+        Date date = Date::fromCivil(MIN_LEDGER_YEAR, 1, 1) + dates[i].first;
+        int count = dates[i].second;
+        cerr << "  " << date.toString() << ": " << abs(count) << (count > 0 ? " expense row(s) without a card row\n" : " card row(s) without an expense row\n");
+    }
+    if (dates.size() > shown)
+        cerr << "  ... and " << dates.size() - shown << " more date(s)\n";
 }
 
-int findMinTravelCost(
-    const vector<City> &cities, const vector<vector<ERoute>> &graph, int source, int destination, int numPeople, int numDays, vector<int> &parent)
+uint64_t snapshotChecksum(const char *data, size_t size)
 {
-    int n = cities.size();
-    vector<int> minCost(n, numeric_limits<int>::max());
-    priority_queue<CNode, vector<CNode>, greater<CNode>> pq;
-    parent.assign(n, -1);
-    minCost[source] = cities[source].hotelCostPerNight * numDays * numPeople;
-    pq.push({source, minCost[source]});
-    while (!pq.empty())
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < size; i++)
     {
-        CNode current = pq.top();
-        pq.pop();
-        for (const ERoute &edge : graph[current.city])
-        {
-            int newCost = current.cost + edge.flightCost * numPeople + cities[edge.destination].hotelCostPerNight * numDays * numPeople;
-            if (newCost < minCost[edge.destination])
-            {
-                minCost[edge.destination] = newCost;
-                parent[edge.destination] = current.city;
-                pq.push({edge.destination, newCost});
-            }
-        }
+        hash ^= (unsigned char)data[i];
+        hash *= 1099511628211ull;
     }
-    return minCost[destination];
+    return hash;
 }
 
-void printPath(const vector<int> &parent, int source, int destination, const vector<City> &cities)
+// The snapshot records the size and write time of the files it was taken from, as the row
+// index does, so it stays fresh when they were written within the same clock tick as it.
+bool isSnapshotFresh(const string &snapshotFile, const vector<string> &sources)
 {
-    vector<string> path;
-    int current = destination;
-    while (current != -1)
+    SnapshotHeader header;
+    ifstream in(snapshotFile, ios::binary);
+    if (!in.read((char *)&header, sizeof(header)) || memcmp(header.magic, "WWLEDGER", 8) != 0 || header.version != SNAPSHOT_VERSION || sources.size() > 2)
+        return false;
+    for (size_t i = 0; i < sources.size(); i++)
     {
-        path.push_back(cities[current].name);
-        if (current == source)
-            break;
-        current = parent[current];
+        error_code ec;
+        uint64_t size = filesystem::file_size(sources[i], ec);
+        if (ec || size != header.sourceSize[i] || fileModifiedTime(sources[i]) != header.sourceModified[i])
+            return false;
     }
-    if (path.back() != cities[source].name)
+    return true;
+}
+
+bool loadLedgerSnapshot(const string &snapshotFile, Ledger &ledger)
+{
+    MappedFile file;
+    if (!file.open(snapshotFile) || file.size < sizeof(SnapshotHeader))
+        return false;
+    SnapshotHeader header;
+    memcpy(&header, file.data, sizeof(header));
+    if (memcmp(header.magic, "WWLEDGER", 8) != 0 || header.version != SNAPSHOT_VERSION ||
+        header.categoryCount <= 0 || header.yearCount < 0 || header.payloadBytes != file.size - sizeof(header))
+        return false;
+    if (header.yearCount > 0 && (header.firstYear < MIN_LEDGER_YEAR || header.firstYear + header.yearCount > MAX_LEDGER_YEAR + 1))
+        return false;
+    size_t cells = (size_t)header.categoryCount * Date::daysBetweenYears(header.firstYear, header.firstYear + header.yearCount);
+    size_t statsBytes = (size_t)header.categoryCount * (sizeof(int64_t) + 2 * sizeof(double));
+    size_t columnBytes = 2 * cells * sizeof(int32_t) + statsBytes;
+    if (header.payloadBytes < columnBytes)
+        return false;
+    const char *payload = file.data + sizeof(header);
+    if (snapshotChecksum(payload, header.payloadBytes) != header.checksum)
+        return false;
+    const char *payloadEnd = payload + header.payloadBytes;
+    const char *section = payload + columnBytes;
+    uint64_t transactionCount, merchantBytes;
+    if ((size_t)(payloadEnd - section) < 2 * sizeof(uint64_t))
+        return false;
+    memcpy(&transactionCount, section, sizeof(uint64_t));
+    memcpy(&merchantBytes, section + sizeof(uint64_t), sizeof(uint64_t));
+    section += 2 * sizeof(uint64_t);
+    if ((uint64_t)(payloadEnd - section) < merchantBytes || (uint64_t)(payloadEnd - section - merchantBytes) / sizeof(Transaction) < transactionCount)
+        return false;
+    vector<string_view> merchantNames;
+    for (const char *merchant = section, *merchantsEnd = section + merchantBytes; merchant < merchantsEnd;)
     {
-        cout << "No path exists from " << cities[source].name << " to " << cities[destination].name << ".\n";
-        return;
+        const char *merchantEnd = (const char *)memchr(merchant, '\n', merchantsEnd - merchant);
+        if (merchantEnd == nullptr)
+            return false;
+        merchantNames.emplace_back(merchant, merchantEnd - merchant);
+        merchant = merchantEnd + 1;
     }
-    reverse(path.begin(), path.end());
-    cout << "Cheapest path: ";
-    for (size_t i = 0; i < path.size(); ++i)
+    const char *records = section + merchantBytes;
+    vector<string> names;
+    const char *name = records + transactionCount * sizeof(Transaction);
+    while (name < payloadEnd)
     {
-        cout << path[i];
-        if (i != path.size() - 1)
-            cout << " -> ";
+        const char *nameEnd = (const char *)memchr(name, '\n', payloadEnd - name);
+        if (nameEnd == nullptr)
+            return false;
+        names.emplace_back(name, nameEnd);
+        name = nameEnd + 1;
     }
-    cout << endl;
+    if ((int)names.size() != header.categoryCount)
+        return false;
+    ledger.setCategories(names, loadCategoryConfig(categoryConfigFilename));
+    ledger.setYears(header.firstYear, header.yearCount);
+    ledger.amounts.resize(cells);
+    ledger.cards.resize(cells);
+    memcpy(ledger.amounts.data(), payload, cells * sizeof(int32_t));
+    memcpy(ledger.cards.data(), payload + cells * sizeof(int32_t), cells * sizeof(int32_t));
+    ledger.rebuildTotals();
+    const char *stats = payload + 2 * cells * sizeof(int32_t);
+    for (CategoryStats &columnStats : ledger.stats)
+    {
+        int64_t count;
+        memcpy(&count, stats, sizeof(count));
+        memcpy(&columnStats.mean, stats + sizeof(count), sizeof(double));
+        memcpy(&columnStats.m2, stats + sizeof(count) + sizeof(double), sizeof(double));
+        columnStats.count = count;
+        stats += sizeof(count) + 2 * sizeof(double);
+    }
+    ledger.transactions = TransactionStore();
+    vector<uint32_t> merchantIds;
+    for (string_view merchant : merchantNames)
+        merchantIds.push_back(ledger.transactions.internMerchant(merchant));
+    for (size_t i = 0; i < transactionCount; i++)
+    {
+        Transaction record;
+        memcpy(&record, records + i * sizeof(Transaction), sizeof(record));
+        if (record.merchant >= merchantIds.size() || record.category >= header.categoryCount)
+            return false;
+        record.merchant = merchantIds[record.merchant];
+        ledger.transactions.append(record);
+    }
+    return true;
 }
 
-void travelExpenseMinimizer()
+bool saveLedgerSnapshot(const string &snapshotFile, const Ledger &ledger, const vector<string> &sources)
 {
-    int numCities;
-    while (true)
+    string payload;
+    size_t cells = ledger.amounts.size();
+    payload.resize(2 * cells * sizeof(int32_t));
+    memcpy(&payload[0], ledger.amounts.data(), cells * sizeof(int32_t));
+    memcpy(&payload[cells * sizeof(int32_t)], ledger.cards.data(), cells * sizeof(int32_t));
+    for (const CategoryStats &columnStats : ledger.stats)
     {
-        cout << "Enter number of cities: ";
-        if (isValidIntInput(numCities) && numCities > 1)
-            break;
-        cout << "Invalid input. Number of cities must be greater than 1.\n";
+        int64_t count = columnStats.count;
+        payload.append((const char *)&count, sizeof(count));
+        payload.append((const char *)&columnStats.mean, sizeof(double));
+        payload.append((const char *)&columnStats.m2, sizeof(double));
     }
-    vector<City> cities(numCities);
-    unordered_map<string, int> cityIndex;
-    cout << "\nEnter city names and hotel costs per night:\n";
-    for (int i = 0; i < numCities; ++i)
+    const TransactionStore &store = ledger.transactions;
+    string merchants;
+    for (string_view merchant : store.merchants)
+        merchants.append(merchant).append("\n");
+    uint64_t transactionCount = store.size(), merchantBytes = merchants.size();
+    payload.append((const char *)&transactionCount, sizeof(uint64_t));
+    payload.append((const char *)&merchantBytes, sizeof(uint64_t));
+    payload.append(merchants);
+    for (size_t i = 0; i < store.size(); i += TRANSACTION_BLOCK_SIZE)
+        payload.append((const char *)store.blocks[i / TRANSACTION_BLOCK_SIZE].get(), min<size_t>(TRANSACTION_BLOCK_SIZE, store.size() - i) * sizeof(Transaction));
+    for (const string &name : ledger.categoryNames)
+        payload.append(name).append("\n");
+    SnapshotHeader header;
+    memcpy(header.magic, "WWLEDGER", 8);
+    header.version = SNAPSHOT_VERSION;
+    header.firstYear = ledger.firstYear;
+    header.yearCount = ledger.yearCount;
+    header.categoryCount = ledger.categoryCount;
+    header.payloadBytes = payload.size();
+    header.checksum = snapshotChecksum(payload.data(), payload.size());
+    for (size_t i = 0; i < 2; i++)
     {
-        string cityName;
-        int hotelCost;
-        cout << "City " << i + 1 << " name: ";
-        cin >> ws;
-        getline(cin, cityName);
-        while (true)
-        {
-            cout << "Hotel cost per night in " << cityName << ": ";
-            if (isValidIntInput(hotelCost))
-                break;
-            cout << "Please enter a valid non-negative number for hotel cost.\n";
-        }
-        cities[i] = {cityName, hotelCost};
-        cityIndex[cityName] = i;
+        error_code ec;
+        header.sourceSize[i] = i < sources.size() ? filesystem::file_size(sources[i], ec) : 0;
+        header.sourceModified[i] = i < sources.size() ? fileModifiedTime(sources[i]) : 0;
+        if (ec)
+            header.sourceSize[i] = 0;
     }
-    int numFlights;
-    while (true)
+    string tempFile = snapshotFile + ".tmp";
+    ofstream out(tempFile, ios::binary | ios::trunc);
+    if (!out.is_open())
+        return false;
+    out.write((const char *)&header, sizeof(header));
+    out.write(payload.data(), payload.size());
+    out.close();
+    if (!out)
     {
-        cout << "\nEnter number of flight routes: ";
-        if (isValidIntInput(numFlights) && numFlights >= 1)
-            break;
-        cout << "Enter at least 1 valid flight route.\n";
+        remove(tempFile.c_str());
+        return false;
     }
-    vector<vector<ERoute>> graph(numCities);
-    for (int i = 0; i < numFlights; ++i)
-    {
-        string from, to;
-        int cost;
-        cout << "\nFlight Route " << i + 1 << ":\n";
-        cout << "From city: ";
-        cin >> ws;
-        getline(cin, from);
-        cout << "To city: ";
-        getline(cin, to);
-        if (cityIndex.find(from) == cityIndex.end() || cityIndex.find(to) == cityIndex.end())
+    error_code ec;
+    filesystem::rename(tempFile, snapshotFile, ec);
+    return !ec;
+}
+
+// The CSV files only hold the daily totals, so a re-import keeps the transaction detail of
+// the snapshot it replaces; the imported totals already include those transactions.
+void carryTransactionDetail(const string &snapshotFile, Ledger &ledger)
+{
+    Ledger previous;
+    if (loadLedgerSnapshot(snapshotFile, previous) && previous.categoryNames == ledger.categoryNames)
+        ledger.transactions = previous.transactions;
+}
+
+int ledgerDate(const Ledger &ledger, int day)
+{
+    return ledger.dateOf(day).number();
+}
+
+string journalCategories(const Ledger &ledger)
+{
+    string names;
+    for (const string &name : ledger.categoryNames)
+        names.append(name).append("\n");
+    return names;
+}
+
+string encodeJournalRecord(int kind, int date, const void *payload, size_t size)
+{
+    JournalRecordHeader header = {(uint32_t)size, 0, date, (uint8_t)kind, {0, 0, 0}};
+    string record(sizeof(header) + size, '\0');
+    memcpy(&record[0], &header, sizeof(header));
+    if (size > 0)
+        memcpy(&record[sizeof(header)], payload, size);
+    header.checksum = (uint32_t)snapshotChecksum(record.data(), record.size());
+    memcpy(&record[0], &header, sizeof(header));
+    return record;
+}
+
+// A day left with no amounts and no cards (a whole-day delete) is journaled as an empty
+// clear-day record instead of a row of zeros.
+string encodeJournalDay(const Ledger &ledger, int day)
+{
+    vector<int32_t> values(2 * ledger.categoryCount);
+    bool empty = true;
+    for (int c = 0; c < ledger.categoryCount; c++)
+    {
+        values[c] = ledger.amount(c, day);
+        values[ledger.categoryCount + c] = ledger.card(c, day);
+        empty = empty && values[c] == 0 && values[ledger.categoryCount + c] == 0;
+    }
+    if (empty)
+        return encodeJournalRecord(JOURNAL_CLEAR_DAY, ledgerDate(ledger, day), nullptr, 0);
+    return encodeJournalRecord(JOURNAL_SET_DAY, ledgerDate(ledger, day), values.data(), values.size() * sizeof(int32_t));
+}
+
+// Transactions are journaled as detail only: the cells they change are journaled as SET
+// records in the same batch, so replay rebuilds the grid from those and never double counts.
+string encodeJournalTransactions(const TransactionStore &store, size_t first)
+{
+    string payload((const char *)&first, sizeof(uint64_t));
+    for (size_t id = first; id < store.size(); id++)
+    {
+        Transaction record = store[id];
+        string_view merchant = store.merchantName(record.merchant);
+        record.merchant = merchant.size();
+        payload.append((const char *)&record, sizeof(record));
+        payload.append(merchant);
+    }
+    return encodeJournalRecord(JOURNAL_TRANSACTIONS, 0, payload.data(), payload.size());
+}
+
+// Records hold the resulting cell values rather than deltas, so replaying one on a base
+// that already contains it is harmless; this is what makes compaction crash-safe.
+// Checks one non-batch record against the ledger without changing it. transactionCount is the
+// size the transaction store will have when the record is applied, so every record of a batch
+// can be checked before the first one is applied.
+bool checkJournalRecord(const Ledger &ledger, const JournalRecordHeader &header, const char *payload, size_t &transactionCount)
+{
+    if (header.kind == JOURNAL_TRANSACTIONS)
+    {
+        uint64_t id;
+        if (header.size < sizeof(id))
+            return false;
+        memcpy(&id, payload, sizeof(id));
+        if (id > transactionCount)
+            return false;
+        for (size_t offset = sizeof(id); offset < header.size; id++)
         {
-            cout << " Invalid city names. Please re-enter this flight route.\n";
-            --i;
-            continue;
+            Transaction record;
+            if (header.size - offset < sizeof(record))
+                return false;
+            memcpy(&record, payload + offset, sizeof(record));
+            offset += sizeof(record);
+            if (record.merchant > header.size - offset || record.category >= ledger.categoryCount)
+                return false;
+            offset += record.merchant;
         }
-        while (true)
+        transactionCount = max<size_t>(transactionCount, id);
+        return true;
+    }
+    Date date;
+    int year = header.date / 10000;
+    if (year < MIN_LEDGER_YEAR || year > MAX_LEDGER_YEAR || !Date::fromNumber(header.date, date))
+        return false;
+    if (header.kind == JOURNAL_CLEAR_DAY)
+        return header.size == 0;
+    if (header.kind == JOURNAL_SET_CELL)
+    {
+        int32_t category;
+        if (header.size != 2 * sizeof(int32_t))
+            return false;
+        memcpy(&category, payload, sizeof(category));
+        return category >= 0 && category < ledger.categoryCount;
+    }
+    if (header.kind == JOURNAL_SET_DAY)
+        return header.size == 2 * (size_t)ledger.categoryCount * sizeof(int32_t);
+    return false;
+}
+
+// A batch is applied whole or not at all: every inner record is checked before any is applied.
+bool applyJournalRecord(Ledger &ledger, const JournalRecordHeader &header, const char *payload, vector<int> *dates)
+{
+    size_t transactionCount = ledger.transactions.size();
+    if (header.kind == JOURNAL_BATCH)
+    {
+        vector<pair<JournalRecordHeader, const char *>> batch;
+        for (size_t offset = 0; offset < header.size;)
         {
-            cout << "Flight cost from " << from << " to " << to << ": ";
-            if (isValidIntInput(cost))
-                break;
-            cout << "Invalid cost. Please enter a non-negative number.\n";
+            JournalRecordHeader inner;
+            if (header.size - offset < sizeof(inner))
+                return false;
+            memcpy(&inner, payload + offset, sizeof(inner));
+            if (inner.kind == JOURNAL_BATCH || inner.size > header.size - offset - sizeof(inner))
+                return false;
+            if (!checkJournalRecord(ledger, inner, payload + offset + sizeof(inner), transactionCount))
+                return false;
+            batch.push_back({inner, payload + offset + sizeof(inner)});
+            offset += sizeof(inner) + inner.size;
         }
-        graph[cityIndex[from]].push_back({cityIndex[to], cost});
+        for (const auto &record : batch)
+            applyJournalRecord(ledger, record.first, record.second, dates);
+        return true;
     }
-    string src, dest;
-    cout << "\nEnter starting city: ";
-    cin >> ws;
-    getline(cin, src);
-    cout << "Enter destination city: ";
-    getline(cin, dest);
-    if (cityIndex.find(src) == cityIndex.end() || cityIndex.find(dest) == cityIndex.end())
+    if (!checkJournalRecord(ledger, header, payload, transactionCount))
+        return false;
+    if (header.kind == JOURNAL_TRANSACTIONS)
     {
-        cout << "One or both cities are invalid.\n";
-        return;
+        uint64_t id;
+        memcpy(&id, payload, sizeof(id));
+        TransactionStore &store = ledger.transactions;
+        for (size_t offset = sizeof(id); offset < header.size; id++)
+        {
+            Transaction record;
+            memcpy(&record, payload + offset, sizeof(record));
+            offset += sizeof(record);
+            string_view merchant(payload + offset, record.merchant);
+            offset += record.merchant;
+            if (id < store.size())
+                continue;
+            record.merchant = store.internMerchant(merchant);
+            store.append(record);
+        }
+        return true;
     }
-    int people;
-    while (true)
+    Date date;
+    Date::fromNumber(header.date, date);
+    int year = date.year();
+    if (dates)
+        dates->push_back(header.date);
+    if (header.kind == JOURNAL_CLEAR_DAY)
     {
-        cout << "Enter number of travelers: ";
-        if (isValidIntInput(people) && people > 0)
-            break;
-        cout << "Invalid number. Please enter a positive value.\n";
+        if (ledger.hasYear(year))
+            ledger.clearDay(ledger.dayOf(date));
+        return true;
     }
-    int days;
-    while (true)
+    vector<int32_t> values(header.size / sizeof(int32_t));
+    memcpy(values.data(), payload, values.size() * sizeof(int32_t));
+    ledger.ensureYear(year);
+    int day = ledger.dayOf(date);
+    if (header.kind == JOURNAL_SET_CELL)
     {
-        cout << "Enter number of days to stay in each city: ";
-        if (isValidIntInput(days) && days > 0)
-            break;
-        cout << "Please enter a positive number of days.\n";
+        ledger.setAmount(values[0], day, values[1]);
+        return true;
     }
-    vector<int> parent;
-    int totalCost = findMinTravelCost(cities, graph, cityIndex[src], cityIndex[dest], people, days, parent);
-    cout << "\nMinimum total cost from " << src << " to " << dest
-         << " for " << people << " traveler(s) over " << days << " day(s) is: Rs " << totalCost << endl;
-    printPath(parent, cityIndex[src], cityIndex[dest], cities);
-    cout << endl;
-    cout << endl;
-}
-
-void initializeDisjointSet(int n)
-{
-    for (int i = 0; i < n; ++i)
+    for (int c = 0; c < ledger.categoryCount; c++)
     {
-        parent[i] = i;
-        rankArr[i] = 0;
+        ledger.setCard(c, day, values[ledger.categoryCount + c]);
+        ledger.setAmount(c, day, values[c]);
     }
+    return true;
 }
 
-int findParent(int x)
-{
-    if (parent[x] != x)
-        parent[x] = findParent(parent[x]);
-    return parent[x];
-}
-
-void unionSets(int x, int y)
+// Stops at the first torn or corrupt record; validBytes is where the next append belongs.
+bool replayJournalFile(const string &journalFile, Ledger &ledger, JournalReplay &replay)
 {
-    int rootX = findParent(x);
-    int rootY = findParent(y);
-    if (rootX != rootY)
+    MappedFile file;
+    if (!file.open(journalFile))
+        return false;
+    size_t offset = 0;
+    while (offset + sizeof(JournalRecordHeader) <= file.size)
     {
-        if (rankArr[rootX] > rankArr[rootY])
+        JournalRecordHeader header;
+        memcpy(&header, file.data + offset, sizeof(header));
+        size_t recordBytes = sizeof(header) + header.size;
+        if (header.size > file.size - offset - sizeof(header))
+            break;
+        string record(file.data + offset, recordBytes);
+        memset(&record[offsetof(JournalRecordHeader, checksum)], 0, sizeof(header.checksum));
+        if ((uint32_t)snapshotChecksum(record.data(), record.size()) != header.checksum)
+            break;
+        const char *payload = file.data + offset + sizeof(header);
+        if (offset == 0)
         {
-            parent[rootY] = rootX;
+            if (header.kind != JOURNAL_CATEGORIES || string(payload, header.size) != journalCategories(ledger))
+            {
+                replay.rejected = true;
+                return true;
+            }
         }
-        else if (rankArr[rootX] < rankArr[rootY])
+        else if (applyJournalRecord(ledger, header, payload, &replay.dates))
         {
-            parent[rootX] = rootY;
+            replay.records++;
         }
         else
         {
-            parent[rootY] = rootX;
-            rankArr[rootX]++;
+            cerr << "Warning: Skipping an invalid record at byte " << offset << " of " << journalFile << endl;
         }
+        offset += recordBytes;
     }
+    replay.validBytes = offset;
+    if (offset < file.size)
+        cerr << "Warning: Ignoring " << file.size - offset << " torn byte(s) at the end of " << journalFile << endl;
+    return true;
 }
 
-void sortEdges(Edge edges[], int edgeCount)
+JournalReplay replayLedgerJournal(const string &journalFile, Ledger &ledger)
 {
-    for (int i = 0; i < edgeCount - 1; ++i)
+    JournalReplay replay;
+    string compacting = journalFile + ".compacting";
+    if (filesystem::exists(compacting))
     {
-        for (int j = 0; j < edgeCount - i - 1; ++j)
-        {
-            if (edges[j].weight > edges[j + 1].weight)
-            {
-                Edge temp = edges[j];
-                edges[j] = edges[j + 1];
-                edges[j + 1] = temp;
-            }
-        }
+        JournalReplay earlier;
+        replayJournalFile(compacting, ledger, earlier);
+        if (earlier.rejected)
+            cerr << "Warning: " << compacting << " was written for different categories and was not replayed." << endl;
+        replay.records += earlier.records;
+        replay.dates = earlier.dates;
+        replay.pendingBase = true;
+    }
+    JournalReplay current;
+    if (replayJournalFile(journalFile, ledger, current))
+    {
+        replay.records += current.records;
+        replay.dates.insert(replay.dates.end(), current.dates.begin(), current.dates.end());
+        replay.validBytes = current.validBytes;
+        replay.rejected = current.rejected;
     }
+    return replay;
 }
 
-void displayGraph(const Edge edges[], int count)
+bool writeFileDurably(const string &path, const string &data)
 {
-    cout << "\nGraph Edges:\n";
-    for (int i = 0; i < count; ++i)
-        cout << "Edge from " << edges[i].src << " to " << edges[i].dest << " with cost Rs. " << edges[i].weight << "\n";
+    string tempFile = path + ".tmp";
+    HANDLE file = CreateFileA(tempFile.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+    DWORD written = 0;
+    bool ok = WriteFile(file, data.data(), (DWORD)data.size(), &written, nullptr) && written == data.size() && FlushFileBuffers(file);
+    CloseHandle(file);
+    error_code ec;
+    if (ok)
+        filesystem::rename(tempFile, path, ec);
+    if (!ok || ec)
+    {
+        remove(tempFile.c_str());
+        return false;
+    }
+    return true;
 }
 
-void allocateEmergencyFunds()
+// The fixed-width layout right-aligns every amount in LEDGER_FIELD_WIDTH columns so that any
+// later value fits over the old one; card ids are single digits in both layouts.
+string formatLedgerRow(const Ledger &ledger, int day, bool cards, bool fixedWidth)
 {
-    Edge edges[MAX_EDGES];
-    int edgeCount = 0;
-    int nodeId = 0;
-    const char *monthNames[] = {
-        "Jan", "Feb", "Mar", "Apr", "May", "Jun",
-        "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
-    for (int month = 0; month < 12; ++month)
+    string row = ledger.dateString(day);
+    char field[16];
+    for (int c = 0; c < ledger.categoryCount; c++)
     {
-        for (int day = 0; day < 31; ++day)
-        {
-            int currentNode = nodeId++;
-            int nextNode = currentNode + 1;
-            if (nextNode >= MAX_NODES)
-                continue;
-            int nextMonth = nextNode / 31;
-            int nextDay = nextNode % 31;
-            if (nextMonth >= 12 || nextDay >= 31)
-                continue;
-            double total1 = 0, total2 = 0;
-            for (int i = 0; i < 3; ++i)
-            {
-                total1 += expenseData[month][day].first[i] + expenseData[month][day].second[i];
-                total2 += expenseData[nextMonth][nextDay].first[i] + expenseData[nextMonth][nextDay].second[i];
-            }
-            double diff = abs(total1 - total2);
-            edges[edgeCount++] = {currentNode, nextNode, diff};
-        }
+        int value = cards ? ledger.card(c, day) : ledger.amount(c, day);
+        snprintf(field, sizeof(field), ",%*d", fixedWidth && !cards ? LEDGER_FIELD_WIDTH : 0, value);
+        row += field;
     }
-    sortEdges(edges, edgeCount);
-    initializeDisjointSet(MAX_NODES);
-    double totalCost = 0;
-    vector<Edge> mst;
-    for (int i = 0; i < edgeCount; ++i)
+    return row;
+}
+
+bool writeLedgerCSV(const Ledger &ledger, const string &expenseFile, const string &cardFile, bool fixedWidth)
+{
+    string expenses = "Date", cards = "Date";
+    for (const string &name : ledger.categoryNames)
     {
-        int u = edges[i].src, v = edges[i].dest;
-        if (findParent(u) != findParent(v))
-        {
-            unionSets(u, v);
-            totalCost += edges[i].weight;
-            mst.push_back(edges[i]);
-        }
+        expenses += "," + name;
+        cards += "," + name;
     }
-    cout << "\nEmergency Fund Transfer Graph Constructed.\n";
-    for (auto &e : mst)
+    for (int d = 0; d < ledger.dayCount(); d++)
     {
-        if (e.weight > 0)
-        {
-            int day1 = e.src % 31;
-            int month1 = e.src / 31;
-            int day2 = e.dest % 31;
-            int month2 = e.dest / 31;
-            double total1 = 0, total2 = 0;
-            for (int i = 0; i < 3; ++i)
-            {
-                total1 += expenseData[month1][day1].first[i] + expenseData[month1][day1].second[i];
-                total2 += expenseData[month2][day2].first[i] + expenseData[month2][day2].second[i];
-            }
-            cout << monthNames[month1] << " " << (day1 + 1) << " ---> "
-                 << monthNames[month2] << " " << (day2 + 1) << "\n"
-                 << "   - " << monthNames[month1] << " " << (day1 + 1) << " Expenses: Rs. " << total1 << "\n"
-                 << "   - " << monthNames[month2] << " " << (day2 + 1) << " Expenses: Rs. " << total2 << "\n"
-                 << "   - Difference (Transfer Need): Rs. " << e.weight << "\n\n";
-        }
+        bool used = false;
+        for (int c = 0; c < ledger.categoryCount && !used; c++)
+            used = ledger.amount(c, d) != 0 || ledger.card(c, d) != 0;
+        if (!used)
+            continue;
+        expenses += "\n" + formatLedgerRow(ledger, d, false, fixedWidth);
+        cards += "\n" + formatLedgerRow(ledger, d, true, fixedWidth);
     }
-    cout << "\nTotal Minimum Transfer Cost: Rs. " << totalCost << "\n";
-    cout << "Summary:\n";
-    cout << "The function 'allocateEmergencyFunds' models daily expenses as a graph and applies Kruskal's algorithm (greedy algorithm) to minimize the cost of transferring emergency funds over time. "
-         << "It treats each day as a node and connects consecutive days with edges weighted by the absolute difference in expense totals. "
-         << "This resembles classic MST problems on LeetCode like 1135 (Connecting Cities With Minimum Cost) and applies greedy and union-find techniques. "
-         << "The time complexity is approximately O(E log E + N), where E is the number of edges and N is the number of nodes.\n\n";
+    return writeFileDurably(expenseFile, expenses) && writeFileDurably(cardFile, cards);
 }
 
-void buildHuffmanTree(const string &data, unordered_map<char, string> &huffmanCode)
+int64_t fileModifiedTime(const string &file)
 {
-    unordered_map<char, int> freq;
-    for (char ch : data)
-        freq[ch]++;
-    priority_queue<HuffmanNode *, vector<HuffmanNode *>, Compare> pq;
-    for (auto &pair : freq)
-        pq.push(new HuffmanNode(pair.first, pair.second));
-    while (pq.size() > 1)
+    error_code ec;
+    auto modified = filesystem::last_write_time(file, ec);
+    return ec ? 0 : (int64_t)modified.time_since_epoch().count();
+}
+
+// Only the date prefix of each row is parsed, so rebuilding is a memchr pass over the file.
+// A date that appears on two rows gets an empty span: the importer sums such rows, so they
+// cannot be patched one at a time.
+void indexLedgerRows(const char *data, size_t size, LedgerFileIndex &index)
+{
+    const char *p = data, *end = data + size, *lineEnd;
+    index.rows.clear();
+    index.size = size;
+    index.fixedWidth = false;
+    if (p == end)
+        return;
+    const char *line = p;
+    p = nextLine(p, end, lineEnd);
+    size_t fixedLength = 10 + parseCSVHeader(line, lineEnd).size() * (LEDGER_FIELD_WIDTH + 1);
+    bool fixedWidth = true;
+    while (p < end)
     {
-        HuffmanNode *left = pq.top();
-        pq.pop();
-        HuffmanNode *right = pq.top();
-        pq.pop();
-        HuffmanNode *node = new HuffmanNode('\0', left->freq + right->freq);
-        node->left = left;
-        node->right = right;
-        pq.push(node);
+        line = p;
+        p = nextLine(p, end, lineEnd);
+        Date date;
+        if (lineEnd - line < 10 || (lineEnd - line > 10 && line[10] != ',') || !Date::parse(line, 10, date))
+            continue;
+        fixedWidth = fixedWidth && (size_t)(lineEnd - line) == fixedLength;
+        auto inserted = index.rows.insert({date.number(), {(uint64_t)(line - data), (uint32_t)(lineEnd - line)}});
+        if (!inserted.second)
+            inserted.first->second.length = 0;
     }
-    function<void(HuffmanNode *, string)> encode = [&](HuffmanNode *node, string str)
-    {
-        if (!node)
-            return;
-        if (node->data != '\0')
-            huffmanCode[node->data] = str;
-        encode(node->left, str + "0");
-        encode(node->right, str + "1"); };
-    encode(pq.top(), "");
+    index.fixedWidth = fixedWidth && !index.rows.empty();
 }
 
-string compressData(const string &data, unordered_map<char, string> &huffmanCode)
+bool buildLedgerFileIndex(const string &file, LedgerFileIndex &index)
 {
-    string compressed = "";
-    for (char ch : data)
-        compressed += huffmanCode[ch];
-    return compressed;
+    MappedFile mapped;
+    if (!mapped.open(file))
+        return false;
+    indexLedgerRows(mapped.data, mapped.size, index);
+    mapped.close();
+    index.modified = fileModifiedTime(file);
+    return true;
 }
 
-string decompressData(const string &compressed, unordered_map<char, string> &huffmanCode)
+bool isLedgerIndexCurrent(const string &file, const LedgerFileIndex &index)
 {
-    unordered_map<string, char> reverseCode;
-    for (auto &pair : huffmanCode)
-        reverseCode[pair.second] = pair.first;
-    string temp = "", decompressed = "";
-    for (char bit : compressed)
+    error_code ec;
+    uint64_t size = filesystem::file_size(file, ec);
+    return !ec && size == index.size && fileModifiedTime(file) == index.modified;
+}
+
+bool loadLedgerIndex(const string &indexFile, LedgerFileIndex &expenses, LedgerFileIndex &cards)
+{
+    MappedFile file;
+    if (!file.open(indexFile) || file.size < 12 + sizeof(uint64_t) || memcmp(file.data, "WWINDEX", 8) != 0)
+        return false;
+    uint32_t version;
+    memcpy(&version, file.data + 8, sizeof(version));
+    uint64_t checksum;
+    memcpy(&checksum, file.data + file.size - sizeof(checksum), sizeof(checksum));
+    if (version != LEDGER_INDEX_VERSION || checksum != snapshotChecksum(file.data, file.size - sizeof(checksum)))
+        return false;
+    const char *p = file.data + 12, *end = file.data + file.size - sizeof(checksum);
+    for (LedgerFileIndex *index : {&expenses, &cards})
     {
-        temp += bit;
-        if (reverseCode.count(temp))
+        uint32_t count;
+        if ((size_t)(end - p) < 2 * sizeof(uint64_t) + 1 + sizeof(count))
+            return false;
+        memcpy(&index->size, p, sizeof(uint64_t));
+        memcpy(&index->modified, p + 8, sizeof(int64_t));
+        index->fixedWidth = p[16] != 0;
+        memcpy(&count, p + 17, sizeof(count));
+        p += 17 + sizeof(count);
+        if ((size_t)(end - p) / 16 < count)
+            return false;
+        index->rows.clear();
+        index->rows.reserve(count);
+        for (uint32_t i = 0; i < count; i++, p += 16)
         {
-            decompressed += reverseCode[temp];
-            temp = "";
+            int32_t date;
+            LedgerRowSpan span;
+            memcpy(&date, p, sizeof(date));
+            memcpy(&span.offset, p + 4, sizeof(span.offset));
+            memcpy(&span.length, p + 12, sizeof(span.length));
+            index->rows[date] = span;
         }
     }
-    return decompressed;
+    return p == end;
 }
 
-void updateExpenseData()
+bool saveLedgerIndex(const string &indexFile, const LedgerFileIndex &expenses, const LedgerFileIndex &cards)
 {
-    string compressFile = "compress.csv";
-    string workingFile = (isValidFile(compressFile)) ? compressFile : filename;
-    ifstream file(workingFile);
-    stringstream buffer;
-    buffer << file.rdbuf();
-    string data = buffer.str();
-    file.close();
-    unordered_map<char, string> huffmanCode;
-    buildHuffmanTree(data, huffmanCode);
-    string compressed = compressData(data, huffmanCode);
-    ofstream outFile(compressFile);
-    outFile << huffmanCode.size() << '\n';
-    for (auto &pair : huffmanCode)
-        outFile << (int)(unsigned char)pair.first << ' ' << pair.second << '\n';
-    outFile << compressed;
-    outFile.close();
-    cout << "CSV data compressed to compress.csv!\n";
-    cout << "Summary:\n";
-    cout << "The function 'updateExpenseData' compresses CSV data using Huffman Encoding by building a frequency-based binary tree and replacing characters with shorter binary codes. "
-         << "It stores both the Huffman dictionary and the compressed bitstring to a new file. "
-         << "This is similar to LeetCode problems involving compression and encoding like 451 (Sort Characters by Frequency) and 271 (Encode and Decode Strings). "
-         << "The time complexity is O(n log n) due to the priority queue operations over n characters in the Huffman tree construction.\n\n";
+    string data("WWINDEX", 8);
+    uint32_t version = LEDGER_INDEX_VERSION;
+    data.append((const char *)&version, sizeof(version));
+    for (const LedgerFileIndex *index : {&expenses, &cards})
+    {
+        uint32_t count = index->rows.size();
+        data.append((const char *)&index->size, sizeof(uint64_t));
+        data.append((const char *)&index->modified, sizeof(int64_t));
+        data.push_back(index->fixedWidth ? 1 : 0);
+        data.append((const char *)&count, sizeof(count));
+        for (const auto &row : index->rows)
+        {
+            int32_t date = row.first;
+            data.append((const char *)&date, sizeof(date));
+            data.append((const char *)&row.second.offset, sizeof(uint64_t));
+            data.append((const char *)&row.second.length, sizeof(uint32_t));
+        }
+    }
+    uint64_t checksum = snapshotChecksum(data.data(), data.size());
+    data.append((const char *)&checksum, sizeof(checksum));
+    return writeFileDurably(indexFile, data);
 }
 
-void restoreExpenseData()
+// Rewrites the rows of the given dates where they already are, right-aligning each value in
+// the width of the field it replaces, and appends rows for new dates. Every patch for both
+// files is planned before anything is written; if any value does not fit, nothing is written
+// and the caller falls back to a full rewrite.
+bool patchLedgerCSV(const Ledger &ledger, const vector<int> &dates, const string &expenseFile, const string &cardFile, LedgerFileIndex &expenseIndex, LedgerFileIndex &cardIndex)
 {
-    string compressFile = "compress.csv";
-    string decompressFile = "decompress.csv";
-    if (!isValidFile(compressFile))
+    const string *files[2] = {&expenseFile, &cardFile};
+    LedgerFileIndex *indexes[2] = {&expenseIndex, &cardIndex};
+    vector<pair<uint64_t, string>> writes[2];
+    string appended[2];
+    vector<pair<int, LedgerRowSpan>> added[2];
+    vector<int> unique = dates;
+    sort(unique.begin(), unique.end());
+    unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+    for (int f = 0; f < 2; f++)
     {
-        cout << "No compressed file found to decompress.\n";
-        return;
-    }
-    ifstream file(compressFile);
-    int mapSize;
-    file >> mapSize;
-    unordered_map<char, string> huffmanCode;
-    for (int i = 0; i < mapSize; ++i)
+        LedgerFileIndex &index = *indexes[f];
+        MappedFile mapped;
+        if (!isLedgerIndexCurrent(*files[f], index) || !mapped.open(*files[f]) || mapped.size != index.size)
+            return false;
+        bool newline = mapped.size == 0 || mapped.data[mapped.size - 1] == '\n';
+        for (int date : unique)
+        {
+            Date calendarDate;
+            if (!ledger.hasYear(date / 10000) || !Date::fromNumber(date, calendarDate))
+                continue;
+            int day = ledger.dayOf(calendarDate);
+            const LedgerRowSpan *span = index.find(date);
+            if (span == nullptr)
+            {
+                bool used = false;
+                for (int c = 0; c < ledger.categoryCount && !used; c++)
+                    used = ledger.amount(c, day) != 0 || ledger.card(c, day) != 0;
+                if (!used)
+                    continue;
+                if (!newline)
+                    appended[f] += "\n";
+                string row = formatLedgerRow(ledger, day, f == 1, index.fixedWidth);
+                added[f].push_back({date, {index.size + appended[f].size(), (uint32_t)row.size()}});
+                appended[f] += row;
+                newline = false;
+                continue;
+            }
+            if (span->length == 0 || span->offset + span->length > mapped.size)
+                return false;
+            string row(mapped.data + span->offset, span->length);
+            size_t field = row.find(',');
+            for (int c = 0; c < ledger.categoryCount; c++)
+            {
+                if (field == string::npos)
+                    return false;
+                size_t fieldEnd = row.find(',', field + 1);
+                size_t width = (fieldEnd == string::npos ? row.size() : fieldEnd) - field - 1;
+                string value = to_string(f == 1 ? ledger.card(c, day) : ledger.amount(c, day));
+                if (value.size() > width)
+                    return false;
+                row.replace(field + 1, width, string(width - value.size(), ' ') + value);
+                field = fieldEnd;
+            }
+            if (field != string::npos)
+                return false;
+            writes[f].push_back({span->offset, row});
+        }
+    }
+    for (int f = 0; f < 2; f++)
     {
-        int chInt;
-        string code;
-        file >> chInt >> code;
-        huffmanCode[(char)chInt] = code;
+        if (writes[f].empty() && appended[f].empty())
+            continue;
+        HANDLE file = CreateFileA(files[f]->c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+        writes[f].push_back({indexes[f]->size, appended[f]});
+        bool ok = true;
+        for (const auto &write : writes[f])
+        {
+            LARGE_INTEGER position;
+            position.QuadPart = (LONGLONG)write.first;
+            DWORD written = 0;
+            ok = ok && SetFilePointerEx(file, position, nullptr, FILE_BEGIN) &&
+                 WriteFile(file, write.second.data(), (DWORD)write.second.size(), &written, nullptr) && written == write.second.size();
+        }
+        ok = ok && FlushFileBuffers(file);
+        CloseHandle(file);
+        if (!ok)
+            return false;
+        for (const auto &row : added[f])
+            indexes[f]->rows[row.first] = row.second;
+        indexes[f]->size += appended[f].size();
+        indexes[f]->modified = fileModifiedTime(*files[f]);
     }
-    file.ignore(); // skip the newline after header
-    string compressed;
-    getline(file, compressed, '\0');
-    file.close();
-    string decompressed = decompressData(compressed, huffmanCode);
-    ofstream outFile(decompressFile);
-    outFile << decompressed;
-    outFile.close();
-    cout << "Data restored from compress.csv to decompress.csv\n";
-    cout << "Summary:\n";
-    cout << "The function 'restoreExpenseData' reads a Huffman-encoded CSV file, reconstructs the encoding map, and decodes the binary string back into original text. "
-         << "It uses a reverse lookup on the binary codes and writes the decompressed result into a new file. "
-         << "This process is conceptually related to decoding problems like LeetCode 271 (Encode and Decode Strings) or 5 (Longest Palindromic Substring, in terms of parsing). "
-         << "The time complexity is O(n), where n is the number of bits in the compressed data.\n\n";
+    return true;
 }
 
-void loadExpenseData(map<string, double> &expenses)
+bool parseMutationDate(const string &text, Date &date)
 {
-    ifstream file(filename);
-    if (!file)
+    if (!Date::parse(text, date))
+        return false;
+    int year = date.year();
+    return year >= MIN_LEDGER_YEAR && year <= MAX_LEDGER_YEAR;
+}
+
+// Validates the whole batch against the ledger as each earlier mutation would leave it, then
+// applies it and persists every touched day with one journal commit, or one CSV rewrite when
+// no journal is open. A failed write restores the touched days, so nothing is half applied.
+bool applyLedgerMutations(Ledger &ledger, const vector<LedgerMutation> &mutations, LedgerJournal &journal, string &error)
+{
+    map<int, vector<int>> simulated;
+    for (size_t i = 0; i < mutations.size(); i++)
     {
-        cout << "No previous expense data found." << endl;
-        return;
+        const LedgerMutation &mutation = mutations[i];
+        string where = mutations.size() > 1 ? "Operation " + to_string(i + 1) + ": " : "";
+        Date date;
+        if (!parseMutationDate(mutation.date, date))
+        {
+            error = where + "Invalid date " + mutation.date;
+            return false;
+        }
+        auto row = simulated.find(date.days);
+        if (row == simulated.end())
+        {
+            vector<int> amounts(ledger.categoryCount, 0);
+            if (ledger.hasYear(date.year()))
+            {
+                for (int c = 0; c < ledger.categoryCount; c++)
+                    amounts[c] = ledger.amount(c, ledger.dayOf(date));
+            }
+            row = simulated.emplace(date.days, amounts).first;
+        }
+        vector<int> &amounts = row->second;
+        bool present = any_of(amounts.begin(), amounts.end(), [](int amount)
+                              { return amount != 0; });
+        if (mutation.kind == LEDGER_ADD)
+        {
+            if (present)
+            {
+                error = where + "An expense entry already exists for " + mutation.date;
+                return false;
+            }
+            if ((int)mutation.amounts.size() != ledger.categoryCount || (int)mutation.cards.size() != ledger.categoryCount)
+            {
+                error = where + "Expected " + to_string(ledger.categoryCount) + " amounts and cards for " + mutation.date;
+                return false;
+            }
+            for (int c = 0; c < ledger.categoryCount; c++)
+            {
+                if (mutation.amounts[c] < 0 || mutation.cards[c] < 0 || mutation.cards[c] > 3)
+                {
+                    error = where + "Invalid amount or card for " + categoryName(c) + " on " + mutation.date;
+                    return false;
+                }
+            }
+            amounts = mutation.amounts;
+        }
+        else if (mutation.kind == LEDGER_UPDATE)
+        {
+            if (!present)
+            {
+                error = where + "No expense entry exists for " + mutation.date;
+                return false;
+            }
+            if (mutation.category < 0 || mutation.category >= ledger.categoryCount || mutation.amounts.size() != 1 || mutation.amounts[0] < 0)
+            {
+                error = where + "Invalid category or amount for " + mutation.date;
+                return false;
+            }
+            amounts[mutation.category] = mutation.amounts[0];
+        }
+        else if (mutation.kind == LEDGER_DELETE)
+        {
+            if (!present)
+            {
+                error = where + "No expenses found for date: " + mutation.date;
+                return false;
+            }
+            fill(amounts.begin(), amounts.end(), 0);
+        }
+        else if (mutation.kind == LEDGER_PURCHASE)
+        {
+            if (mutation.category < 0 || mutation.category >= ledger.categoryCount || mutation.amounts.size() != 1 || mutation.amounts[0] <= 0 ||
+                mutation.cards.size() != 1 || mutation.cards[0] < 0 || mutation.cards[0] > 3 || mutation.time < -1 || mutation.time >= 86400 ||
+                mutation.merchant.find('\n') != string::npos)
+            {
+                error = where + "Invalid purchase on " + mutation.date;
+                return false;
+            }
+            if ((long long)amounts[mutation.category] + mutation.amounts[0] > numeric_limits<int>::max())
+            {
+                error = where + "Purchases on " + mutation.date + " overflow the daily total";
+                return false;
+            }
+            amounts[mutation.category] += mutation.amounts[0];
+        }
+        else
+        {
+            error = where + "Unknown operation";
+            return false;
+        }
     }
-    string category;
-    double amount;
-    while (file >> category >> amount)
+    for (const auto &row : simulated)
+        ledger.ensureYear(Date(row.first).year());
+    auto dayOf = [&](int date)
+    { return ledger.dayOf(Date(date)); };
+    map<int, pair<vector<int>, vector<int>>> undo;
+    for (const auto &row : simulated)
     {
-        expenses[category] += amount;
+        int d = dayOf(row.first);
+        auto &saved = undo[row.first];
+        for (int c = 0; c < ledger.categoryCount; c++)
+        {
+            saved.first.push_back(ledger.amount(c, d));
+            saved.second.push_back(ledger.card(c, d));
+        }
     }
-    file.close();
+    // Every change to a cell is recorded as a transaction: purchases for added amounts and
+    // adjustments for updates and deletions, so the history is never rewritten.
+    size_t firstTransaction = ledger.transactions.size();
+    vector<int> days;
+    vector<pair<int, int>> cells;
+    for (const LedgerMutation &mutation : mutations)
+    {
+        Date date;
+        parseMutationDate(mutation.date, date);
+        int d = ledger.dayOf(date);
+        uint32_t merchant = ledger.transactions.internMerchant(mutation.merchant);
+        auto adjust = [&](int c, int target)
+        {
+            if (target != ledger.amount(c, d))
+                ledger.addTransaction({date, target - ledger.amount(c, d), merchant, -1, (uint16_t)c, 0, TRANSACTION_ADJUSTMENT});
+        };
+        if (mutation.kind == LEDGER_UPDATE)
+        {
+            adjust(mutation.category, mutation.amounts[0]);
+            cells.push_back({mutation.category, d});
+            continue;
+        }
+        if (mutation.kind == LEDGER_PURCHASE)
+            ledger.addTransaction({date, mutation.amounts[0], merchant, mutation.time, (uint16_t)mutation.category, (uint8_t)mutation.cards[0], TRANSACTION_PURCHASE});
+        for (int c = 0; c < ledger.categoryCount && mutation.kind != LEDGER_PURCHASE; c++)
+        {
+            ledger.setCard(c, d, mutation.kind == LEDGER_ADD ? mutation.cards[c] : 0);
+            if (mutation.kind == LEDGER_ADD && mutation.amounts[c] > 0)
+                ledger.addTransaction({date, mutation.amounts[c], merchant, mutation.time, (uint16_t)c, (uint8_t)mutation.cards[c], TRANSACTION_PURCHASE});
+            else
+                adjust(c, 0);
+        }
+        if (find(days.begin(), days.end(), d) == days.end())
+            days.push_back(d);
+    }
+    bool persisted = journal.file != INVALID_HANDLE_VALUE ? journal.commit(ledger, days, cells, firstTransaction)
+                                                          : writeLedgerCSV(ledger, journal.expenseFile, journal.cardFile);
+    if (persisted)
+        return true;
+    const FraudAlertStream *alertStream = ledger.alertStream;
+    ledger.alertStream = nullptr;
+    for (const auto &saved : undo)
+    {
+        int d = dayOf(saved.first);
+        for (int c = 0; c < ledger.categoryCount; c++)
+        {
+            ledger.setCard(c, d, saved.second.second[c]);
+            ledger.setAmount(c, d, saved.second.first[c]);
+        }
+    }
+    ledger.transactions.truncate(firstTransaction);
+    ledger.alertStream = alertStream;
+    error = "Could not save the changes; the ledger was left as it was";
+    return false;
 }
 
-void saveExpenseData(const map<string, double> &expenses)
+// One operation per line, '#' starts a comment:
+//   add DATE CATEGORY=AMOUNT[:CARD]...   (unlisted categories are 0)
+//   buy DATE CATEGORY AMOUNT [card=N] [merchant=NAME] [time=HH:MM[:SS]]
+//   update DATE CATEGORY AMOUNT
+//   delete DATE
+vector<LedgerMutation> parseLedgerMutations(istream &in, const Ledger &ledger)
 {
-    ofstream file(filename);
-    for (const auto &entry : expenses)
+    vector<LedgerMutation> mutations;
+    string line;
+    for (int lineNumber = 1; getline(in, line); ++lineNumber)
     {
-        file << entry.first << " " << entry.second << endl;
+        vector<string> tokens = splitCommandLine(line);
+        if (tokens.empty() || tokens[0][0] == '#')
+            continue;
+        string where = "Line " + to_string(lineNumber) + ": ";
+        if (tokens.size() < 2)
+            throw invalid_argument(where + "Expected an operation and a date");
+        LedgerMutation mutation;
+        mutation.date = tokens[1];
+        auto number = [&](const string &text)
+        {
+            int value = 0;
+            auto parsed = from_chars(text.data(), text.data() + text.size(), value);
+            if (parsed.ec != errc() || parsed.ptr != text.data() + text.size())
+                throw invalid_argument(where + "'" + text + "' is not a whole number");
+            return value;
+        };
+        auto category = [&](const string &name)
+        {
+            int c = ledger.findCategory(name);
+            if (c < 0)
+                throw invalid_argument(where + "Unknown category " + name);
+            return c;
+        };
+        if (tokens[0] == "add")
+        {
+            mutation.kind = LEDGER_ADD;
+            mutation.amounts.assign(ledger.categoryCount, 0);
+            mutation.cards.assign(ledger.categoryCount, 0);
+            for (size_t i = 2; i < tokens.size(); i++)
+            {
+                size_t equals = tokens[i].find('='), colon = tokens[i].find(':');
+                if (equals == string::npos)
+                    throw invalid_argument(where + "Expected CATEGORY=AMOUNT[:CARD], got '" + tokens[i] + "'");
+                int c = category(tokens[i].substr(0, equals));
+                mutation.amounts[c] = number(tokens[i].substr(equals + 1, colon == string::npos ? string::npos : colon - equals - 1));
+                if (colon != string::npos)
+                    mutation.cards[c] = number(tokens[i].substr(colon + 1));
+            }
+        }
+        else if (tokens[0] == "update" && tokens.size() == 4)
+        {
+            mutation.kind = LEDGER_UPDATE;
+            mutation.category = category(tokens[2]);
+            mutation.amounts.push_back(number(tokens[3]));
+        }
+        else if (tokens[0] == "delete" && tokens.size() == 2)
+            mutation.kind = LEDGER_DELETE;
+        else if (tokens[0] == "buy" && tokens.size() >= 4)
+        {
+            mutation.kind = LEDGER_PURCHASE;
+            mutation.category = category(tokens[2]);
+            mutation.amounts.push_back(number(tokens[3]));
+            mutation.cards.push_back(0);
+            for (size_t i = 4; i < tokens.size(); i++)
+            {
+                size_t equals = tokens[i].find('=');
+                string key = tokens[i].substr(0, equals), value = equals == string::npos ? "" : tokens[i].substr(equals + 1);
+                if (key == "card" && equals != string::npos)
+                    mutation.cards[0] = number(value);
+                else if (key == "merchant" && equals != string::npos)
+                    mutation.merchant = value;
+                else if (key == "time" && equals != string::npos && (mutation.time = parseTimeOfDay(value)) >= 0)
+                    continue;
+                else
+                    throw invalid_argument(where + "Expected card=N, merchant=NAME or time=HH:MM[:SS], got '" + tokens[i] + "'");
+            }
+        }
+        else
+            throw invalid_argument(where + "Expected 'add DATE CATEGORY=AMOUNT[:CARD]...', 'buy DATE CATEGORY AMOUNT [card=N] [merchant=NAME] [time=HH:MM]', "
+                                           "'update DATE CATEGORY AMOUNT' or 'delete DATE'");
+        mutations.push_back(mutation);
     }
-    file.close();
+    return mutations;
 }
 
-void listAllExpenses(const map<string, double> &expenses)
+int parseTimeOfDay(const string &text)
 {
-    cout << "All Expenses:\n";
-    for (const auto &entry : expenses)
+    int parts[3] = {0, 0, 0}, count = 0;
+    const char *p = text.data(), *end = text.data() + text.size();
+    while (p < end && count < 3)
     {
-        cout << entry.first << ": " << entry.second << "\n";
+        auto parsed = from_chars(p, end, parts[count++]);
+        if (parsed.ec != errc() || parsed.ptr - p != 2)
+            return -1;
+        p = parsed.ptr;
+        if (p < end && *p++ != ':')
+            return -1;
     }
+    if (count < 2 || p != end || text.back() == ':' || parts[0] > 23 || parts[1] > 59 || parts[2] > 59)
+        return -1;
+    return parts[0] * 3600 + parts[1] * 60 + parts[2];
+}
+
+string formatTimeOfDay(int seconds)
+{
+    if (seconds < 0)
+        return "";
+    char text[16];
+    snprintf(text, sizeof(text), "%02d:%02d:%02d", seconds / 3600, seconds / 60 % 60, seconds % 60);
+    return text;
 }
 
-vector<LoanRepaymentResult> optimizeLoanRepayment(const vector<vector<pair<vector<int>, vector<int>>>> &expenseData, int income, int month, vector<Loan> &loans)
+size_t LedgerJournal::recover(Ledger &ledger, const string &journalFile, const string &expenses, const string &cards)
 {
-    int totalSpent = 0;
-    for (int day = 0; day < 31; ++day)
+    path = journalFile;
+    expenseFile = expenses;
+    cardFile = cards;
+    JournalReplay replay = replayLedgerJournal(path, ledger);
+    if (!loadLedgerIndex(ledgerIndexFilename, expenseIndex, cardIndex))
+        expenseIndex = cardIndex = LedgerFileIndex();
+    uint64_t validBytes = replay.validBytes;
+    records = replay.records;
+    if (replay.rejected)
     {
-        auto ess = expenseData[month][day].first;
-        auto nonEss = expenseData[month][day].second;
-        for (int x : ess)
-            totalSpent += x;
-        for (int x : nonEss)
-            totalSpent += x;
+        cerr << "Warning: " << path << " was written for different categories; it was moved to " << path << ".rejected and not replayed." << endl;
+        error_code ec;
+        filesystem::rename(path, path + ".rejected", ec);
+        validBytes = 0;
     }
-    cout << "\n Total Spent: Rs." << totalSpent << endl;
-    cout << " Total Income: Rs." << income << endl;
-    int availableFunds = max(0, income - totalSpent);
-    cout << " Available for Loan Repayment: Rs." << availableFunds << endl
-         << endl;
-    vector<pair<int, double>> loanPriority;
-    for (int i = 0; i < loans.size(); ++i)
+    for (auto index : {make_pair(&expenseFile, &expenseIndex), make_pair(&cardFile, &cardIndex)})
     {
-        double density = loans[i].interestRate / loans[i].amount;
-        loanPriority.push_back({i, density});
+        if (!isLedgerIndexCurrent(*index.first, *index.second))
+            buildLedgerFileIndex(*index.first, *index.second);
     }
-    sort(loanPriority.begin(), loanPriority.end(), [](auto &a, auto &b)
-         { return a.second > b.second; });
-    vector<LoanRepaymentResult> results(loans.size());
-    for (int i = 0; i < loans.size(); ++i)
+    dirty = replay.dates;
+    if (replay.pendingBase)
     {
-        results[i] = {loans[i].id, loans[i].amount, 0.0, loans[i].amount, loans[i].amount * loans[i].interestRate / 100.0};
+        if (fold(ledger, dirty, LEDGER_LAYOUT_KEEP))
+        {
+            remove((path + ".compacting").c_str());
+            validBytes = 0;
+            records = 0;
+            dirty.clear();
+        }
+        else
+            cerr << "Warning: Could not finish the interrupted compaction of " << path << endl;
     }
-    for (const auto &entry : loanPriority)
+    if (!open(ledger, validBytes))
+        cerr << "Warning: Cannot open journal " << path << "; edits will not be saved." << endl;
+    return replay.records;
+}
+
+bool LedgerJournal::open(const Ledger &ledger, uint64_t validBytes)
+{
+    file = CreateFileA(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+    LARGE_INTEGER end;
+    end.QuadPart = (LONGLONG)validBytes;
+    if (!SetFilePointerEx(file, end, nullptr, FILE_BEGIN) || !SetEndOfFile(file))
     {
-        int idx = entry.first;
-        if (availableFunds <= 0)
-            break;
-        double pay = min(loans[idx].amount, (double)availableFunds);
-        results[idx].amountPaid = pay;
-        results[idx].unpaidAmount = loans[idx].amount - pay;
-        results[idx].interestIncurred = results[idx].unpaidAmount * loans[idx].interestRate / 100.0;
-        availableFunds -= pay;
+        CloseHandle(file);
+        file = INVALID_HANDLE_VALUE;
+        return false;
     }
-    return results;
+    bytes = validBytes;
+    appended = durable = 0;
+    failed = stopping = false;
+    committer = thread(&LedgerJournal::commitLoop, this);
+    if (validBytes > 0)
+        return true;
+    string names = journalCategories(ledger);
+    return append(JOURNAL_CATEGORIES, 0, names.data(), names.size());
 }
 
-void displayLoanResults(const vector<LoanRepaymentResult> &results)
+// Appends block until their record is on disk. Records queued while a flush is running
+// share the next write and FlushFileBuffers, which is the group commit.
+bool LedgerJournal::append(int kind, int date, const void *payload, size_t size)
 {
-    cout << "\nLoan Repayment Summary:\n";
-    cout << "+-----------+----------------+-----------+-----------+-------------------+" << endl;
-    cout << left
-         << "| " << setw(10) << "Loan ID"
-         << "| " << setw(15) << "Original (Rs.)"
-         << "| " << setw(10) << "Paid"
-         << "| " << setw(10) << "Unpaid"
-         << "| " << setw(18) << "Interest Incurred"
-         << "|" << endl;
-    cout << "+-----------+----------------+-----------+-----------+-------------------+" << endl;
-    for (const auto &r : results)
+    unique_lock<mutex> guard(lock);
+    if (file == INVALID_HANDLE_VALUE || failed)
+        return false;
+    pending += encodeJournalRecord(kind, date, payload, size);
+    uint64_t ticket = ++appended;
+    wake.notify_one();
+    committed.wait(guard, [&]()
+                   { return durable >= ticket || failed; });
+    return durable >= ticket;
+}
+
+void LedgerJournal::commitLoop()
+{
+    unique_lock<mutex> guard(lock);
+    while (true)
     {
-        cout << left
-             << "| " << setw(10) << r.id
-             << "| " << setw(15) << fixed << setprecision(2) << r.originalAmount
-             << "| " << setw(10) << r.amountPaid
-             << "| " << setw(10) << r.unpaidAmount
-             << "| " << setw(18) << ("Rs. " + to_string(r.interestIncurred))
-             << "|" << endl;
+        wake.wait(guard, [&]()
+                  { return !pending.empty() || stopping; });
+        if (pending.empty())
+            return;
+        string batch;
+        batch.swap(pending);
+        uint64_t ticket = appended;
+        guard.unlock();
+        DWORD written = 0;
+        bool ok = WriteFile(file, batch.data(), (DWORD)batch.size(), &written, nullptr) && written == batch.size() && FlushFileBuffers(file);
+        guard.lock();
+        if (ok)
+        {
+            durable = ticket;
+            bytes += batch.size();
+        }
+        else
+            failed = true;
+        committed.notify_all();
     }
-    cout << "+-----------+----------------+-----------+-----------+-------------------+" << endl;
 }
 
-void optimizeInvestmentPortfolio(int totalRiskBudget)
+// Writes a whole mutation batch as one record so replay applies all of it or none of it.
+// Transactions, whole days (set-day, or clear-day once a delete empties them) and single
+// cells go into one batch; only a batch that holds a single record is written unwrapped.
+bool LedgerJournal::commit(const Ledger &ledger, const vector<int> &days, const vector<pair<int, int>> &cells, size_t firstTransaction)
 {
-    vector<Investment> investments = {{101, 2000, 5000, 20}, {102, 100, 500, 10}, {103, 10000, 50000, 50}, {104, 100, 500, 10}, {105, 6000, 10000, 50}, {106, 2000, 10000, 20}, {107, 5000, 20000, 30}, {108, 1000, 5000, 15}, {109, 3000, 15000, 25}, {110, 4000, 20000, 40}};
-    sort(investments.begin(), investments.end(), [](const Investment &a, const Investment &b)
-         { return (a.returnPerUnit / a.riskPerUnit) > (b.returnPerUnit / b.riskPerUnit); });
-    double totalReturn = 0;
-    vector<pair<int, int>> selected;
-    for (const auto &inv : investments)
+    string batch;
+    size_t count = 0;
+    if (firstTransaction < ledger.transactions.size())
     {
-        int maxUnitsWeCanTake = min(inv.maxUnits, totalRiskBudget / (int)inv.riskPerUnit);
-        if (maxUnitsWeCanTake >= 1)
+        batch += encodeJournalTransactions(ledger.transactions, firstTransaction);
+        count++;
+    }
+    for (int day : days)
+    {
+        batch += encodeJournalDay(ledger, day);
+        count++;
+    }
+    for (const auto &cell : cells)
+    {
+        if (find(days.begin(), days.end(), cell.second) != days.end())
+            continue;
+        int32_t values[2] = {cell.first, ledger.amount(cell.first, cell.second)};
+        batch += encodeJournalRecord(JOURNAL_SET_CELL, ledgerDate(ledger, cell.second), values, sizeof(values));
+        count++;
+    }
+    if (count == 0)
+        return true;
+    bool ok;
+    if (count == 1)
+    {
+        JournalRecordHeader header;
+        memcpy(&header, batch.data(), sizeof(header));
+        ok = append(header.kind, header.date, batch.data() + sizeof(header), header.size);
+    }
+    else
+        ok = append(JOURNAL_BATCH, 0, batch.data(), batch.size());
+    if (!ok)
+        return false;
+    records++;
+    for (int day : days)
+        dirty.push_back(ledgerDate(ledger, day));
+    for (const auto &cell : cells)
+        dirty.push_back(ledgerDate(ledger, cell.second));
+    if (bytes >= JOURNAL_COMPACT_BYTES)
+        compact(ledger, false);
+    return true;
+}
+
+// Rotates the journal to ledger.journal.compacting and folds a copy of the ledger into new
+// CSV files and a snapshot on a background thread; edits keep going to a fresh journal.
+// If the fold fails the .compacting file is kept, replayed and finished on the next start.
+// A .compacting journal left by a fold that failed is folded again, from the current ledger,
+// before the journal is rotated; if that fails too, compaction is given up until the next
+// start, which replays both journals, instead of rewriting the CSV on every later commit.
+bool LedgerJournal::compact(const Ledger &ledger, bool wait, int layout)
+{
+    if (compactor.joinable())
+        compactor.join();
+    string compacting = path + ".compacting";
+    if (foldFailed)
+        return false;
+    if (filesystem::exists(compacting))
+    {
+        vector<int> dates = unfolded;
+        dates.insert(dates.end(), dirty.begin(), dirty.end());
+        if (!fold(ledger, dates, layout))
         {
-            int usedRisk = maxUnitsWeCanTake * inv.riskPerUnit;
-            totalRiskBudget -= usedRisk;
-            totalReturn += maxUnitsWeCanTake * inv.returnPerUnit;
-            selected.push_back({inv.id, maxUnitsWeCanTake});
+            foldFailed = true;
+            cerr << "Warning: Could not compact " << compacting << " again; compaction is off until the next start and " << path << " keeps every edit." << endl;
+            return false;
         }
-        if (totalRiskBudget <= 0)
-            break;
+        remove(compacting.c_str());
+        unfolded.clear();
     }
-    cout << "\nInvestment Portfolio Optimization:\n"
-         << endl;
-    cout << "+----------------+-------------------+--------------------+" << endl;
-    cout << left << "| " << setw(15) << "Investment ID" << "| " << setw(18) << "Units Selected"
-         << "| " << setw(19) << "Return (Rs.)" << "|" << endl;
-    cout << "+----------------+-------------------+--------------------+" << endl;
-    for (const auto &entry : selected)
     {
-        int id = entry.first;
-        int units = entry.second;
-        double ret = units * investments[id % 100 - 1].returnPerUnit;
-        cout << left << "| " << setw(15) << id << "| " << setw(18) << units
-             << "| Rs. " << setw(15) << fixed << setprecision(2) << ret << "|" << endl;
+        unique_lock<mutex> guard(lock);
+        committed.wait(guard, [&]()
+                       { return durable >= appended || failed; });
+        if (file == INVALID_HANDLE_VALUE || failed)
+            return false;
+        CloseHandle(file);
+        error_code ec;
+        filesystem::rename(path, compacting, ec);
+        file = CreateFileA(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr, ec ? OPEN_ALWAYS : CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (ec || file == INVALID_HANDLE_VALUE)
+        {
+            cerr << "Warning: Could not rotate journal " << path << endl;
+            failed = file == INVALID_HANDLE_VALUE;
+            return false;
+        }
+        string names = journalCategories(ledger);
+        pending = encodeJournalRecord(JOURNAL_CATEGORIES, 0, names.data(), names.size());
+        ++appended;
+        bytes = 0;
+        records = 0;
+        wake.notify_one();
     }
-    cout << "+----------------+-------------------+--------------------+" << endl;
-    cout << "\nTotal Expected Return: Rs." << fixed << setprecision(2) << totalReturn << endl;
+    vector<int> dates;
+    dates.swap(dirty);
+    compactor = thread([this, base = ledger, dates, layout, compacting]()
+                       {
+        if (fold(base, dates, layout))
+            remove(compacting.c_str());
+        else
+        {
+            unfolded = dates;
+            cerr << "Warning: Could not compact " << compacting << " into " << expenseFile << "; it will be retried at the next compaction." << endl;
+        } });
+    if (wait)
+        compactor.join();
+    return true;
 }
 
-void generateBudgetPlan(double monthlyIncome)
+// Patches the changed rows in place when the layout is kept and every value fits, otherwise
+// rewrites both files. The snapshot is written last, so until it exists the journal being
+// folded is still needed to rebuild the ledger.
+bool LedgerJournal::fold(const Ledger &base, const vector<int> &dates, int layout)
 {
-    cout << fixed << setprecision(2);
-    cout << "\n Monthly Budget for Income: " << monthlyIncome << "\n"
-         << endl;
-    cout << " NEEDS (50%) - " << 0.50 * monthlyIncome << endl;
-    cout << "   Rent (30%): " << 0.30 * monthlyIncome << endl;
-    cout << "   Groceries (10%): " << 0.10 * monthlyIncome << endl;
-    cout << "   Utilities (5%): " << 0.05 * monthlyIncome << endl;
-    cout << "   Transportation (5%): " << 0.05 * monthlyIncome << endl;
-    cout << "\n WANTS (15%) - " << 0.15 * monthlyIncome << endl;
-    cout << "   Shopping + EMIs (10%): " << 0.10 * monthlyIncome << endl;
-    cout << "   Entertainment + Travel (5%): " << 0.05 * monthlyIncome << endl;
-    cout << "\n SAVINGS + INVESTMENTS (20%) - " << 0.20 * monthlyIncome << endl;
-    cout << "   Health + Term Insurance (5%): " << 0.05 * monthlyIncome << endl;
-    cout << "   SIP (in Mutual Funds) (10%): " << 0.10 * monthlyIncome << endl;
-    cout << "   Emergency Fund (5%): " << 0.05 * monthlyIncome << endl;
-    cout << "\n OTHERS (15%) - " << 0.15 * monthlyIncome << endl;
-    cout << "   Upskilling (5%): " << 0.05 * monthlyIncome << endl;
-    cout << "   Family Support (10%): " << 0.10 * monthlyIncome << endl;
-    cout << "\n TOTAL: " << monthlyIncome << " distributed across needs, wants, savings, and others.\n"
-         << endl;
-    cout << "Summary:\n";
-    cout << "The function 'generateBudgetPlan' categorizes a user's monthly income into Needs, Wants, Savings + Investments, and Others based on fixed percentages. "
-         << "It calculates and displays each category and sub-category with exact monetary allocations using standard financial budgeting principles. \n\n";
+    if (layout != LEDGER_LAYOUT_KEEP || !patchLedgerCSV(base, dates, expenseFile, cardFile, expenseIndex, cardIndex))
+    {
+        bool fixedWidth = layout == LEDGER_LAYOUT_KEEP ? expenseIndex.fixedWidth : layout == LEDGER_LAYOUT_FIXED;
+        if (!writeLedgerCSV(base, expenseFile, cardFile, fixedWidth))
+            return false;
+        buildLedgerFileIndex(expenseFile, expenseIndex);
+        buildLedgerFileIndex(cardFile, cardIndex);
+    }
+    if (!saveLedgerIndex(ledgerIndexFilename, expenseIndex, cardIndex))
+        cerr << "Warning: Could not write ledger index " << ledgerIndexFilename << endl;
+    return saveLedgerSnapshot(snapshotFilename, base, {expenseFile, cardFile});
 }
 
-void encrypt(const string &inputFilename, const string &outputFilename, int key)
+void LedgerJournal::close()
 {
-    ifstream input(inputFilename);
-    ofstream output(outputFilename);
-    if (!input.is_open() || !output.is_open())
-    {
-        cout << "Error opening files.\n";
-        return;
-    }
-    char ch;
-    while (input.get(ch))
+    if (compactor.joinable())
+        compactor.join();
+    if (committer.joinable())
     {
-        if (isalpha(ch))
-        {
-            char base = islower(ch) ? 'a' : 'A';
-            ch = (ch - base + key) % 26 + base;
-        }
-        else if (isdigit(ch))
         {
-            ch = (ch - '0' + key) % 10 + '0';
+            lock_guard<mutex> guard(lock);
+            stopping = true;
         }
-        output.put(ch);
+        wake.notify_all();
+        committer.join();
     }
-    input.close();
-    output.close();
-    cout << "Encrypted " << inputFilename << "into " << outputFilename << endl;
+    if (file != INVALID_HANDLE_VALUE)
+        CloseHandle(file);
+    file = INVALID_HANDLE_VALUE;
 }
 
-void decrypt(const string &inputFilename, const string &outputFilename, int key)
+void displayExpenses()
 {
-    ifstream input(inputFilename);
-    ofstream output(outputFilename);
-    if (!input.is_open() || !output.is_open())
+    bool hasData = false;
+    vector<int> widths(ledger.categoryCount);
+    string header = "|    Date    |";
+    for (int c = 0; c < ledger.categoryCount; c++)
     {
-        cout << "Error opening files.\n";
-        return;
+        string title = categoryName(c);
+        if (!title.empty())
+            title[0] = toupper((unsigned char)title[0]);
+        widths[c] = max<int>(title.size(), 3) + 2;
+        header += "  " + title + string(widths[c] - title.size(), ' ') + "|";
     }
-    char ch;
-    while (input.get(ch))
+    string rule(header.size(), '-');
+    cout << "\n" << rule << "\n";
+    cout << header << "\n";
+    cout << rule << "\n";
+    int dayCount = ledger.dayCount();
+    vector<char> active(dayCount, 0);
+    for (int c = 0; c < ledger.categoryCount; c++)
     {
-        if (isalpha(ch))
-        {
-            char base = islower(ch) ? 'a' : 'A';
-            ch = ((ch - base - key) % 26 + 26) % 26 + base;
-        }
-        else if (isdigit(ch))
-        {
-            ch = ((ch - '0' - key) % 10 + 10) % 10 + '0';
-        }
-        output.put(ch);
+        const int *column = ledger.amountColumn(c);
+        for (int d = 0; d < dayCount; d++)
+            active[d] |= column[d] > 0;
     }
-    input.close();
-    output.close();
-    cout << "Decrypted " << inputFilename << " into " << outputFilename << endl;
-}
-
-RentBuyResult rentVsBuyDecision(const RentBuyInput &input, double interestRate, double rentIncreaseRate)
-{
-    RentBuyResult result;
-    result.totalRentCost = 0;
-    double currentRent = input.rentCost;
-    for (int i = 0; i < input.yearsToOwnProperty; ++i)
+    for (int d = 0; d < dayCount; d++)
     {
-        result.totalRentCost += currentRent * 12;
-        currentRent *= (1 + rentIncreaseRate);
+        if (!active[d])
+            continue;
+        hasData = true;
+        cout << "| " << ledger.dateString(d) << " |";
+        for (int c = 0; c < ledger.categoryCount; c++)
+            cout << " " << right << setw(widths[c]) << ledger.amount(c, d) << " |";
+        cout << "\n";
     }
-    double remainingPrincipal = input.propertyCost;
-    double monthlyRate = interestRate / 12;
-    int months = 0;
-    double totalEmiPaid = 0;
-    while (remainingPrincipal > 0 && months < 1000 * 12)
+    if (!hasData)
     {
-        double monthlyInterest = remainingPrincipal * monthlyRate;
-        double principalPaid = input.emi - monthlyInterest;
-        if (principalPaid <= 0)
-        {
-            result.totalBuyCost = -1;
-            result.yearsToOwnProperty = -1;
-            result.recommendation = "EMI too low to ever repay the loan.";
-            return result;
-        }
-        remainingPrincipal -= principalPaid;
-        totalEmiPaid += input.emi;
-        months++;
+        cout << "No expenses recorded." << endl;
     }
-    result.totalBuyCost = totalEmiPaid;
-    result.yearsToOwnProperty = (months + 11) / 12;
-    result.recommendation = (result.totalBuyCost < result.totalRentCost) ? "Buy" : "Rent";
-    return result;
+    else
+    {
+        cout << rule << "\n";
+        cout << "|   Total    |";
+        for (int c = 0; c < ledger.categoryCount; c++)
+            cout << " " << right << setw(widths[c]) << ledger.rangeTotal(c, 0, dayCount) << " |";
+        cout << "\n";
+    }
+    cout << rule << "\n";
+    pauseFor(500);
 }
 
-InventoryResult optimizeInventory(const vector<Product> &products, int capacity)
+void addExpense()
 {
-    int n = products.size();
-    vector<vector<int>> dp(n + 1, vector<int>(capacity + 1, 0));
-    vector<vector<bool>> taken(n + 1, vector<bool>(capacity + 1, false));
-    for (int i = 1; i <= n; ++i)
+    string date;
+    cout << "Enter the date (YYYY-MM-DD): ";
+    cin >> date;
+    if (!Date::isWellFormed(date.data(), date.size()))
     {
-        const Product &p = products[i - 1];
-        for (int c = 0; c <= capacity; ++c)
-        {
-            dp[i][c] = dp[i - 1][c];
-            if (p.size <= c)
-            {
-                int newProfit = dp[i - 1][c - p.size] + p.profit;
-                if (newProfit > dp[i][c])
-                {
-                    dp[i][c] = newProfit;
-                    taken[i][c] = true;
-                }
-            }
-        }
+        cout << "Invalid date format! Please enter in YYYY-MM-DD format.\n";
+        return;
     }
-    InventoryResult result;
-    result.totalProfit = dp[n][capacity];
-    int c = capacity;
-    for (int i = n; i >= 1; --i)
+    Date parsed;
+    if (!Date::parse(date, parsed))
     {
-        if (taken[i][c])
-        {
-            result.selectedProductIndices.push_back(i - 1);
-            c -= products[i - 1].size;
-        }
+        cout << "Invalid date! Please enter a real calendar date.\n";
+        return;
     }
-    return result;
-}
-
-SchedulerResult scheduleRecurringExpenses(const vector<RecurringBill> &bills, int income)
-{
-    vector<RecurringBill> sorted = bills;
-    sort(sorted.begin(), sorted.end(), [](const RecurringBill &a, const RecurringBill &b)
-         { return a.penalty > b.penalty; });
-    int remaining = income;
-    SchedulerResult result;
-    for (const auto &bill : sorted)
+    int year = parsed.year();
+    if (year < MIN_LEDGER_YEAR || year > MAX_LEDGER_YEAR)
     {
-        if (bill.amount <= remaining)
-        {
-            result.paymentSchedule.push_back("Paid: " + bill.name);
-            remaining -= bill.amount;
-        }
-        else
-        {
-            result.paymentSchedule.push_back("Unpaid: " + bill.name + " (Penalty: " + to_string(bill.penalty) + ")");
-            result.totalPenaltyPaid += bill.penalty;
-        }
+        cout << "Invalid date! Year out of range.\n";
+        return;
     }
-    return result;
-}
-
-void runRentVsBuySimulator(vector<int> &monthlyTotals)
-{
-    RentBuyInput input;
-    double totalMonthlyExpenses = monthlyTotals[9];
-    cout << "Enter monthly income: ";
-    if (!isValidDoubleInput(input.income))
+    bool dateExists = false;
+    if (ledger.hasYear(year))
     {
-        cout << "Invalid amount entered! Please enter a correct income value.\n";
+        int dayIndex = ledger.dayOf(parsed);
+        for (int c = 0; c < ledger.categoryCount && !dateExists; c++)
+            dateExists = ledger.amount(c, dayIndex) != 0;
+    }
+    if (dateExists)
+    {
+        cout << "Error: An expense entry already exists for this date!\n";
         return;
     }
-    if (input.income < totalMonthlyExpenses)
+    map<string, double> expenseEntry;
+    map<string, int> cards;
+    for (const auto &category : ledger.categoryNames)
     {
-        char proceed;
-        cout << "Your income is less than monthly expenses (" << totalMonthlyExpenses << "). Do you want to proceed further? (y/n): ";
-        cin >> proceed;
-        if (proceed != 'y' && proceed != 'Y')
+        double amount;
+        int c_id;
+        cout << "Enter amount " << category << ": ";
+        if (!isValidDoubleInput(amount))
         {
-            cout << "Exiting as per your choice.\n";
+            cout << "Invalid amount entered! Please enter a non-negative number.\n";
             return;
         }
+        if (amount > 0)
+        {
+            while (true)
+            {
+                cout << "Choose the card ID you used for the payment:\n";
+                cout << "1 -> A\n2 -> B\n3 -> C\n4 -> None\n";
+                cout << "Enter choice: ";
+                if (!isValidIntInput(c_id))
+                {
+                    cout << "Invalid input! Please enter a number between 1 and 4.\n";
+                    return;
+                }
+                if (c_id >= 1 && c_id <= 3)
+                {
+                    break;
+                }
+                else if (c_id == 4)
+                {
+                    c_id = 0;
+                    break;
+                }
+                else
+                {
+                    cout << "Wrong choice! Valid options: 1-4.\n";
+                }
+            }
+        }
+        else
+        {
+            c_id = 0;
+        }
+        expenseEntry[category] = amount;
+        cards[category] = c_id;
     }
-    cout << "Enter monthly rent cost: ";
-    if (!isValidDoubleInput(input.rentCost))
-    {
-        cout << "Invalid amount entered! Please enter a valid rent cost.\n";
-        return;
-    }
-    double savings = input.income - totalMonthlyExpenses;
-    if (input.rentCost < savings)
+    LedgerMutation mutation;
+    mutation.kind = LEDGER_ADD;
+    mutation.date = date;
+    for (const auto &category : ledger.categoryNames)
     {
-        cout << " The rent is affordable, as it is less than your monthly savings (Rs. " << fixed << setprecision(2) << savings << ").\n";
+        mutation.amounts.push_back((int)expenseEntry[category]);
+        mutation.cards.push_back(cards[category]);
     }
+    string error;
+    if (applyLedgerMutations(ledger, {mutation}, journal, error))
+        cout << "Expense added successfully!\n";
     else
+        cout << "Error: " << error << "\n";
+    cout << "Summary:\n";
+    cout << "The function 'addExpense()' allows users to log daily essential and non-essential expenses by entering amounts and selecting the payment card used. "
+         << "It validates the date format, prevents duplicate entries, stores data in structured maps, updates a 2D vector, and appends the day to the ledger journal. "
+         << "This logic is comparable to LeetCode problems involving input validation, hashmap usage, and matrix data handling (e.g., Insert Delete GetRandom O(1)). "
+         << "It uses concepts from date parsing, maps, vectors, file handling, and error checking. Time complexity is roughly O(n), where n is the number of categories.\n\n";
+}
+
+void updateExpense()
+{
+    string date;
+    double newAmount;
+    displayExpenses();
+    cout << "Enter the date (YYYY-MM-DD) to update the Expences: ";
+    cin >> date;
+    if (!Date::isWellFormed(date.data(), date.size()))
     {
-        cout << " The rent might stretch your budget, as it exceeds your monthly savings.\n";
-    }
-    cout << "Enter home loan EMI: ";
-    if (!isValidDoubleInput(input.emi))
-    {
-        cout << "Invalid amount entered! Please enter a valid EMI value.\n";
+        cout << "Invalid date format! Please enter in YYYY-MM-DD format.\n";
         return;
     }
-    cout << "Enter total property cost: ";
-    if (!isValidDoubleInput(input.propertyCost))
+    Date parsed;
+    if (!Date::parse(date, parsed))
     {
-        cout << "Invalid amount entered! Please enter a valid property cost.\n";
+        cout << "Invalid date! Month or day out of range.\n";
         return;
     }
-    cout << "Enter years of stay: ";
-    if (!isValidIntInput(input.yearsToOwnProperty))
+    int year = parsed.year();
+    if (ledger.yearCount == 0)
     {
-        cout << "Invalid input! Please enter a valid year.\n";
+        cout << "Error: No expense data loaded in memory.\n";
         return;
     }
-    double emiInterestRate;
-    cout << "Enter home loan interest rate (e.g., 0.08 for 8%): ";
-    if (!isValidDoubleInput(emiInterestRate))
+    if (ledger.hasYear(year))
     {
-        cout << "Invalid amount entered! Please enter a valid home loan interest rate.\n";
-        return;
+        int choice;
+        cout << "Select a category to update:\n";
+        for (int c = 0; c < ledger.categoryCount; c++)
+        {
+            string title = categoryName(c);
+            title[0] = toupper((unsigned char)title[0]);
+            cout << c + 1 << " - " << title << "\n";
+        }
+        cout << "Enter your choice (1-" << ledger.categoryCount << "): ";
+        if (!isValidIntInput(choice))
+        {
+            cout << "Invalid input! Please enter a number between 1 and " << ledger.categoryCount << ".\n";
+            return;
+        }
+        if (choice < 1 || choice > ledger.categoryCount)
+        {
+            cout << "Invalid choice! Please enter a number between 1 and " << ledger.categoryCount << ".\n";
+            return;
+        }
+        cout << "Enter the new amount: ";
+        if (!isValidDoubleInput(newAmount))
+        {
+            cout << "Invalid amount entered! Please enter a non-negative number.\n";
+            return;
+        }
+        if (newAmount < 0)
+        {
+            cout << "Amount cannot be negative.\n";
+            return;
+        }
+        LedgerMutation mutation;
+        mutation.kind = LEDGER_UPDATE;
+        mutation.date = date;
+        mutation.category = choice - 1;
+        mutation.amounts.push_back((int)newAmount);
+        string error;
+        if (applyLedgerMutations(ledger, {mutation}, journal, error))
+        {
+            cout << "Expense updated successfully in memory!" << endl;
+            cout << "Expense for date " << date << " has been updated successfully.\n";
+        }
+        else
+            cout << "Error: " << error << ".\n";
     }
-    double rentIncreaseRate;
-    cout << "Enter expected annual rent increase rate (e.g., 0.05 for 5%): ";
-    if (!isValidDoubleInput(rentIncreaseRate))
+    else
     {
-        cout << "Invalid amount entered! Please enter a valid rent increase rate.\n";
-        return;
+        cout << "Expense not found in the data structure!" << endl;
     }
-    RentBuyResult result = rentVsBuyDecision(input, emiInterestRate, rentIncreaseRate);
-    cout << "\n--- Rent vs Buy Analysis ---\n";
-    cout << "Total cost if Renting (with yearly rent increase): Rs. " << fixed << setprecision(2) << result.totalRentCost << endl;
-    cout << "Total cost if Buying (with compound EMI): Rs. " << fixed << setprecision(2) << result.totalBuyCost << endl;
-    cout << "Years to own the property: " << fixed << setprecision(2) << result.yearsToOwnProperty << endl;
-    cout << "Recommendation: " << result.recommendation << endl;
-    Sleep(2000);
-    cout << endl;
+    displayExpenses();
+    cout << "Summary:\n";
+    cout << "The function 'updateExpense' allows a user to update a specific category of daily expenses for a given date, validating inputs and modifying the in-memory ledger before appending the changed cell to the ledger journal. "
+         << "It combines file I/O handling, data structure traversal, and user input validation. "
+         << "This approach is similar to LeetCode problems like 'Edit Distance in a Matrix' where data updates must maintain consistency. "
+         << "Key topics include file handling, 2D vector manipulation, string parsing, and input validation, with an overall time complexity of O(log n) for the range-total update plus one small append.\n\n";
 }
 
-void runInventoryOptimizer()
+bool deleteExpenses(const string &date)
 {
-    int capacity;
-    cout << "Enter warehouse capacity: ";
-    if (!isValidIntInput(capacity))
+    LedgerMutation mutation;
+    mutation.kind = LEDGER_DELETE;
+    mutation.date = date;
+    string error;
+    if (!applyLedgerMutations(ledger, {mutation}, journal, error))
     {
-        cout << "Invalid input! Please enter a valid capacity value.\n";
-        return;
+        cerr << error << ". Nothing deleted.\n";
+        return false;
     }
-    vector<Product> products;
-    products.push_back({4, 400});
-    products.push_back({3, 300});
-    products.push_back({2, 200});
-    products.push_back({1, 100});
-    products.push_back({5, 500});
-    products.push_back({6, 600});
-    products.push_back({7, 700});
-    products.push_back({8, 800});
-    products.push_back({9, 900});
-    products.push_back({10, 1000});
-    products.push_back({11, 1100});
-    products.push_back({12, 1200});
-    InventoryResult result = optimizeInventory(products, capacity);
-    cout << "\n--- Inventory Optimization Result ---\n";
-    cout << "Max Profit: " << result.totalProfit << "\n";
-    cout << "Selected Products:\n";
-    cout << "ID\tSize\tProfit\n";
-    for (int idx : result.selectedProductIndices)
+    cout << "Expenses for " << date << " deleted successfully.\n";
+    return true;
+}
+
+void menu();
+
+// Subset-sum kernels. shiftOr ORs a reachability bitset (bit j: sum j is reachable) with
+// itself shifted up by one item's amount; relax folds one item into a row of fewest-entry
+// counts. Both sweep from high to low, so every read sees the row from before the item.
+void shiftOrScalar(uint64_t *reach, size_t words, int shift)
+{
+    size_t wordShift = shift / 64;
+    int bitShift = shift % 64;
+    for (size_t w = words; w-- > wordShift;)
     {
-        const Product &p = products[idx];
-        cout << "P" << idx + 1 << "\t" << p.size << "\t" << p.profit << "\n";
+        uint64_t moved = reach[w - wordShift] << bitShift;
+        if (bitShift != 0 && w > wordShift)
+            moved |= reach[w - wordShift - 1] >> (64 - bitShift);
+        reach[w] |= moved;
     }
-    int usedCapacity = 0;
-    for (int idx : result.selectedProductIndices)
-        usedCapacity += products[idx].size;
-    cout << "Used Capacity: " << usedCapacity << " / " << capacity << endl;
-    Sleep(2000);
-    cout << endl;
 }
 
-void runRecurringExpenseScheduler(vector<int> &monthlyTotals)
+void relaxCountsScalar(int *count, int target, int amount)
 {
-    int income;
-    cout << "Enter your monthly income: ";
-    if (!isValidIntInput(income) || income <= 0)
+    for (int j = target; j >= amount; j--)
+        count[j] = min(count[j], count[j - amount] + 1);
+}
+
+#ifdef APS_X86_SIMD
+void shiftOrSSE2(uint64_t *reach, size_t words, int shift)
+{
+    size_t wordShift = shift / 64, w = words;
+    const __m128i left = _mm_cvtsi32_si128(shift % 64), right = _mm_cvtsi32_si128(64 - shift % 64);
+    for (; w >= wordShift + 3; w -= 2)
     {
-        cout << "Invalid input! Please enter a positive integer for income.\n";
-        return;
+        __m128i high = _mm_loadu_si128((const __m128i *)(reach + w - 2 - wordShift));
+        __m128i low = _mm_loadu_si128((const __m128i *)(reach + w - 3 - wordShift));
+        __m128i *cell = (__m128i *)(reach + w - 2);
+        _mm_storeu_si128(cell, _mm_or_si128(_mm_loadu_si128(cell), _mm_or_si128(_mm_sll_epi64(high, left), _mm_srl_epi64(low, right))));
     }
-    int month;
-    cout << "Enter month number (1-12): ";
-    if (!isValidIntInput(month) || month < 1 || month > 12)
+    shiftOrScalar(reach, w, shift);
+}
+
+void relaxCountsSSE2(int *count, int target, int amount)
+{
+    const __m128i one = _mm_set1_epi32(1);
+    int end = target + 1;
+    for (; end - 4 >= amount; end -= 4)
     {
-        cout << "Invalid month! Please enter a number between 1 and 12.\n";
-        return;
+        __m128i from = _mm_add_epi32(_mm_loadu_si128((const __m128i *)(count + end - 4 - amount)), one);
+        __m128i *cell = (__m128i *)(count + end - 4);
+        __m128i current = _mm_loadu_si128(cell);
+        __m128i better = _mm_cmpgt_epi32(current, from);
+        _mm_storeu_si128(cell, _mm_or_si128(_mm_and_si128(better, from), _mm_andnot_si128(better, current)));
     }
-    double totalMonthExpenses = 0;
-    totalMonthExpenses = monthlyTotals[month - 1];
-    double availableIncome = income - totalMonthExpenses;
-    cout << "Total expenses for month " << month << ": " << totalMonthExpenses << endl;
-    cout << "Available income after expenses: " << availableIncome << endl;
-    if (availableIncome <= 0)
+    relaxCountsScalar(count, end - 1, amount);
+}
+
+APS_TARGET_AVX2 void shiftOrAVX2(uint64_t *reach, size_t words, int shift)
+{
+    size_t wordShift = shift / 64, w = words;
+    const __m128i left = _mm_cvtsi32_si128(shift % 64), right = _mm_cvtsi32_si128(64 - shift % 64);
+    for (; w >= wordShift + 5; w -= 4)
     {
-        cout << "Warning: You have no disposable income for scheduling bills.\n";
-        return;
+        __m256i high = _mm256_loadu_si256((const __m256i *)(reach + w - 4 - wordShift));
+        __m256i low = _mm256_loadu_si256((const __m256i *)(reach + w - 5 - wordShift));
+        __m256i *cell = (__m256i *)(reach + w - 4);
+        _mm256_storeu_si256(cell, _mm256_or_si256(_mm256_loadu_si256(cell), _mm256_or_si256(_mm256_sll_epi64(high, left), _mm256_srl_epi64(low, right))));
     }
-    vector<RecurringBill> bills = {
-        {"Electricity", 1500, 10, 100},
-        {"Credit Card", 4000, 5, 200},
-        {"Mobile Bill", 1000, 15, 50},
-        {"Internet", 1200, 20, 80}};
-    SchedulerResult result = scheduleRecurringExpenses(bills, static_cast<int>(availableIncome));
-    cout << "\n--- Recurring Expense Schedule ---\n";
-    for (const string &entry : result.paymentSchedule)
+    shiftOrScalar(reach, w, shift);
+}
+
+APS_TARGET_AVX2 void relaxCountsAVX2(int *count, int target, int amount)
+{
+    const __m256i one = _mm256_set1_epi32(1);
+    int end = target + 1;
+    for (; end - 8 >= amount; end -= 8)
     {
-        cout << entry << endl;
+        __m256i from = _mm256_add_epi32(_mm256_loadu_si256((const __m256i *)(count + end - 8 - amount)), one);
+        __m256i *cell = (__m256i *)(count + end - 8);
+        _mm256_storeu_si256(cell, _mm256_min_epi32(_mm256_loadu_si256(cell), from));
     }
-    cout << "Total Penalty Paid: Rs." << result.totalPenaltyPaid << endl;
-    Sleep(2000);
+    relaxCountsScalar(count, end - 1, amount);
 }
+#endif
 
-void menu(vector<int> &monthlyTotals)
+vector<SubsetSumKernel> availableSubsetSumKernels()
 {
-    int choice;
-    while (true)
+    vector<SubsetSumKernel> kernels = {{"scalar", shiftOrScalar, relaxCountsScalar}};
+#ifdef APS_X86_SIMD
+    kernels.push_back({"sse2", shiftOrSSE2, relaxCountsSSE2});
+    if (cpuSupportsAVX2())
+        kernels.push_back({"avx2", shiftOrAVX2, relaxCountsAVX2});
+#endif
+    return kernels;
+}
+
+SubsetSumKernel &subsetSumKernel()
+{
+    static SubsetSumKernel kernel = availableSubsetSumKernels().back();
+    return kernel;
+}
+
+// Every reachable sum j equals the savings it represents, so the DP only tracks the fewest
+// entries reaching each j. One rolling row of counts plus one bit per (item, sum) recording
+// whether the item was taken keeps memory at O(goal + n * goal / 8).
+void fillSavingsMatrix(const SavingsItem *items, int n, int goal, vector<int> &count, vector<uint64_t> &taken)
+{
+    size_t words = (size_t)goal / 64 + 1;
+    count.assign((size_t)goal + 1, SAVINGS_UNREACHED);
+    taken.assign(n * words, 0);
+    count[0] = 0;
+    for (int i = 0; i < n; i++)
     {
-        try
+        int expense = items[i].amount;
+        uint64_t *row = taken.data() + i * words;
+        for (int j = goal; j >= expense && expense > 0; j--)
         {
-            cout << "\nExpense Tracker Menu:";
-            cout << "\n1. Display Expenses";
-            cout << "\n2. Add Expense";
-            cout << "\n3. Update Expense";
-            cout << "\n4. Delete Expense";
-            cout << "\n5. Design A budget plan";
-            cout << "\n6. Allocate Emergency Funds";
-            cout << "\n7. Compress Data";
-            cout << "\n8. Decompress Data";
-            cout << "\n9. Optimize Savings";
-            cout << "\n10. Credit Card Payment Strategy";
-            cout << "\n11. Best Flight optimization";
-            cout << "\n12. Loan Repayment Strategy";
-            cout << "\n13. Investment Portfolio Optimization";
-            cout << "\n14. Encrypt CSV";
-            cout << "\n15. Decrypt CSV";
-            cout << "\n16. Rent vs Buy";
-            cout << "\n17. Inventory Optimizer";
-            cout << "\n18. Recurring Expense Scheduler";
-            cout << "\n19. Exit";
-            cout << "\nEnter your choice: ";
-            cin >> choice;
-            if (cin.fail())
-            {
-                throw invalid_argument("Input must be an integer.");
-            }
-            if (choice < 1 || choice > 19)
+            if (count[j - expense] + 1 < count[j])
             {
-                throw out_of_range("Choice must be between 1 and 16.");
+                count[j] = count[j - expense] + 1;
+                row[j >> 6] |= 1ULL << (j & 63);
             }
-            string filename = "OctExpenses.csv";
-            string filename2 = "carddetails.csv";
-            string date;
-            vector<CreditCard> cardVec(4);
-            cardVec[1] = {"A", 3.5, 500, 15};
-            cardVec[2] = {"B", 2.0, 300, 12};
-            cardVec[3] = {"C", 1.5, 200, 18};
-            vector<PaymentResult> payVec;
-            vector<Loan> loans = {Loan(1, 15000, 10.5), Loan(2, 20000, 8.2),
-                                  Loan(3, 12000, 12.0), Loan(4, 5000, 5.0), Loan(5, 8000, 7.5),
-                                  Loan(6, 10000, 9.0), Loan(7, 7000, 6.5)};
-            vector<LoanRepaymentResult> payVecLoan;
-            vector<Investment> investments;
-            vector<InvestmentSelection> result;
-            switch (choice)
-            {
-            case 1:
-                displayExpenses();
-                Sleep(2000);
-                break;
-            case 2:
-                addExpense();
-                break;
-            case 3:
-                updateExpense();
-                break;
-            case 4:
-                displayExpenses();
-                cout << "Enter the date (YYYY-MM-DD) to delete all expenses of that day: ";
-                cin >> date;
-                if (!validateDateFormat(date))
-                {
-                    cout << "Invalid date format! Please enter in YYYY-MM-DD format.\n";
-                    break;
-                }
-                if (deleteExpenses(filename, date) || deleteExpenses(filename2, date))
-                {
-                    cout << "Expenses for date " << date << " have been deleted successfully.\n";
-                    displayExpenses();
-                    cout << "Summary:\n";
-                    cout << "The function `deleteExpenses` removes all expense data for a specified date from both memory and a CSV file. "
-                         << "It first parses the date, validates it, clears the corresponding in-memory entries, then rewrites the CSV without that date's entry. "
-                         << "This resembles LeetCode file-handling or string-parsing problems like 'Delete Operation for Two Strings'. "
-                         << "It uses topics like file I/O, error handling, date parsing, and string manipulation. Time complexity is O(n), where n is the number of lines in the file.\n\n";
-                    Sleep(2000);
-                }
-                else
-                {
-                    cout << "No expenses found for the entered date.\n";
-                }
-                break;
-            case 5:
+        }
+    }
+}
+
+// Walks the taken bits back from total; a matrix filled for any goal >= total gives the same
+// selection as one filled for total itself.
+void selectFromSavingsMatrix(const SavingsItem *items, int n, int total, const vector<uint64_t> &taken, vector<SavingsItem> &selected)
+{
+    size_t words = taken.size() / max(n, 1), first = selected.size();
+    for (int i = n - 1, j = total; i >= 0 && j > 0; i--)
+    {
+        if (taken[i * words + (j >> 6)] >> (j & 63) & 1)
+        {
+            selected.push_back(items[i]);
+            j -= items[i].amount;
+        }
+    }
+    reverse(selected.begin() + first, selected.end());
+}
+
+SavingsResult optimizeSavingsMatrix(const SavingsItem *items, int n, int goal)
+{
+    vector<int> count;
+    vector<uint64_t> taken;
+    fillSavingsMatrix(items, n, goal, count, taken);
+    SavingsResult result;
+    result.goal = goal;
+    int best = goal;
+    while (count[best] == SAVINGS_UNREACHED)
+        best--;
+    result.totalSavings = best;
+    result.entryCount = count[best];
+    selectFromSavingsMatrix(items, n, best, taken, result.selected);
+    return result;
+}
+
+// Phase one of the bitset engine: bit j of reach is set when some subset sums to j <= goal,
+// built with one word-parallel shift-or per item.
+void reachableSavings(const vector<SavingsItem> &items, int goal, vector<uint64_t> &reach)
+{
+    const SubsetSumKernel &kernel = subsetSumKernel();
+    reach.assign((size_t)goal / 64 + 1, 0);
+    reach[0] = 1;
+    int reachable = 0;
+    for (const SavingsItem &item : items)
+    {
+        if (item.amount <= 0 || item.amount > goal)
+            continue;
+        reachable = (int)min<long long>(goal, (long long)reachable + item.amount);
+        kernel.shiftOr(reach.data(), (size_t)reachable / 64 + 1, item.amount);
+    }
+}
+
+// The largest total <= goal that some subset reaches.
+int bestReachableSavings(const vector<SavingsItem> &items, int goal)
+{
+    vector<uint64_t> reach;
+    reachableSavings(items, goal, reach);
+    return highestReachable(reach, goal);
+}
+
+// The highest set bit at or below goal; bit 0 (the empty subset) is always set.
+int highestReachable(const vector<uint64_t> &reach, int goal)
+{
+    int w = goal / 64, bit = goal % 64;
+    while (!(reach[w] >> bit & 1))
+    {
+        if (bit-- == 0)
+        {
+            w--;
+            bit = 63;
+        }
+    }
+    return w * 64 + bit;
+}
+
+void fewestEntryCounts(const SavingsItem *first, const SavingsItem *last, int target, vector<int> &count)
+{
+    const SubsetSumKernel &kernel = subsetSumKernel();
+    count.assign((size_t)target + 1, SAVINGS_UNREACHED);
+    count[0] = 0;
+    int reachable = 0;
+    for (; first != last; ++first)
+    {
+        if (first->amount <= 0 || first->amount > target)
+            continue;
+        reachable = (int)min<long long>(target, (long long)reachable + first->amount);
+        kernel.relax(count.data(), reachable, first->amount);
+    }
+}
+
+// Phase two: Hirschberg-style reconstruction of a fewest-entry subset summing exactly to
+// target. Each level splits the items, pairs forward counts of one half with those of the
+// other to pick how target divides between them, and recurses; once the taken-bit matrix
+// of a piece fits in SAVINGS_MATRIX_BITS it is solved directly. Memory stays O(target).
+void selectFewestEntries(const SavingsItem *first, const SavingsItem *last, int target, vector<SavingsItem> &selected)
+{
+    size_t n = last - first;
+    if (target == 0 || n == 0)
+        return;
+    if (n * ((size_t)target + 1) <= SAVINGS_MATRIX_BITS)
+    {
+        SavingsResult piece = optimizeSavingsMatrix(first, (int)n, target);
+        selected.insert(selected.end(), piece.selected.begin(), piece.selected.end());
+        return;
+    }
+    const SavingsItem *middle = first + n / 2;
+    int split = 0;
+    {
+        vector<int> left, right;
+        fewestEntryCounts(first, middle, target, left);
+        fewestEntryCounts(middle, last, target, right);
+        long long best = numeric_limits<long long>::max();
+        for (int s = 0; s <= target; s++)
+        {
+            long long total = (long long)left[s] + right[target - s];
+            if (total < best)
             {
-                double income;
-                cout << "Enter your monthly income in Rupees: ";
-                cin >> income;
-                if (cin.fail() || income <= 0)
-                {
-                    cin.clear();
-                    cin.ignore(numeric_limits<streamsize>::max(), '\n');
-                    cout << "Invalid income amount. Please enter a positive numeric value.\n";
-                    break;
-                }
-                cout << "\nGenerating your personalized budget plan...\n\n";
-                generateBudgetPlan(income);
-                Sleep(5000);
-                break;
+                best = total;
+                split = s;
             }
-            case 6:
-                allocateEmergencyFunds();
-                Sleep(200);
-                break;
-            case 7:
-                updateExpenseData();
-                Sleep(200);
-                break;
-            case 8:
-                restoreExpenseData();
-                Sleep(200);
-                break;
-            case 9:
-            {
-                int goal;
-                while (true)
-                {
-                    cout << "Enter your target savings goal (in Rs): ";
-                    if (isValidIntInput(goal) && goal > 0)
-                        break;
-                    cout << "Invalid input. Please enter a **positive** numeric value for your goal.\n";
-                }
-                int excessAmount;
-                while (true)
-                {
+        }
+    }
+    selectFewestEntries(first, middle, split, selected);
+    selectFewestEntries(middle, last, target - split, selected);
+}
+
+// Goals whose taken-bit matrix would exceed SAVINGS_MATRIX_BITS switch to the bitset engine.
+// It reports the same savings and entry count; among equally short selections it may pick a
+// different one than the matrix DP.
+SavingsResult optimizeSavingsPlan(const vector<SavingsItem> &items, int goal)
+{
+    if (items.size() * ((size_t)goal + 1) <= SAVINGS_MATRIX_BITS)
+        return optimizeSavingsMatrix(items.data(), items.size(), goal);
+    SavingsResult result;
+    result.goal = goal;
+    result.totalSavings = bestReachableSavings(items, goal);
+    selectFewestEntries(items.data(), items.data() + items.size(), result.totalSavings, result.selected);
+    result.entryCount = result.selected.size();
+    return result;
+}
+
+void displaySavingsResult(const SavingsResult &result)
+{
+    cout << "\nTotal Savings Achieved: " << result.totalSavings
+         << " using " << result.entryCount << " expense entries.\n";
+    cout << "-------------------------------------------------\n";
+    cout << "By reducing the following expenses, you can successfully meet your savings target upto " << result.totalSavings << "!\n";
+    cout << "-------------------------------------------------\n";
+    cout << "+-----------+---------------+-----------------+" << endl;
+    cout << left
+         << "| " << setw(10) << "Amount"
+         << "| " << setw(14) << "Date (MM-DD)"
+         << "| " << setw(16) << "Category"
+         << "|" << endl;
+    cout << "+-----------+---------------+-----------------+" << endl;
+    for (const SavingsItem &entry : result.selected)
+    {
+        cout << left
+             << "| Rs. " << setw(6) << entry.amount
+             << "| " << setw(14) << entry.date.toString().substr(5)
+             << "| " << setw(16) << categoryName(entry.category)
+             << "|" << endl;
+    }
+    cout << "+-----------+--------------+------------------+" << endl;
+    cout << endl;
+}
+vector<SavingsItem> collectNonEssentialExpenses(const Ledger &ledger)
+{
+    vector<pair<int, SavingsItem>> entries;
+    int dayCount = ledger.dayCount();
+    for (int c = 0; c < ledger.categoryCount; ++c)
+    {
+        if (ledger.essential[c])
+            continue;
+        const int *column = ledger.amountColumn(c);
+        for (int d = 0; d < dayCount; ++d)
+        {
+            if (column[d] != 0)
+                entries.push_back({d, {column[d], ledger.dateOf(d), c}});
+        }
+    }
+    stable_sort(entries.begin(), entries.end(), [](const auto &a, const auto &b)
+                { return a.first < b.first; });
+    vector<SavingsItem> items;
+    items.reserve(entries.size());
+    for (const auto &entry : entries)
+        items.push_back(entry.second);
+    return items;
+}
+
+// Records the largest reachable total at or below every sum up to maxGoal once, so any goal
+// <= maxGoal is answered without another DP pass. Small goals fill the taken-bit matrix and
+// read selections straight off it; larger ones only keep the shift-or reachability bitset
+// and rebuild each selection with the Hirschberg pass the first time its goal is asked for.
+void SavingsIndex::build(const Ledger &ledger, int goal)
+{
+    version = ledger.version;
+    maxGoal = goal;
+    items = collectNonEssentialExpenses(ledger);
+    taken.clear();
+    count.clear();
+    answers.clear();
+    vector<uint64_t> reach;
+    if (items.size() * ((size_t)goal + 1) <= SAVINGS_MATRIX_BITS)
+        fillSavingsMatrix(items.data(), items.size(), goal, count, taken);
+    else
+        reachableSavings(items, goal, reach);
+    best.resize((size_t)goal + 1);
+    for (int j = 0; j <= goal; j++)
+    {
+        bool reached = !taken.empty() ? count[j] != SAVINGS_UNREACHED : (reach[j / 64] >> (j % 64) & 1) != 0;
+        best[j] = reached ? j : best[j - 1];
+    }
+}
+
+SavingsResult SavingsIndex::query(int goal) const
+{
+    auto cached = answers.find(goal);
+    if (cached != answers.end())
+        return cached->second;
+    int n = items.size();
+    SavingsResult result;
+    if (taken.empty() && (size_t)n * ((size_t)goal + 1) <= SAVINGS_MATRIX_BITS)
+        result = optimizeSavingsMatrix(items.data(), n, goal);
+    else
+    {
+        result.goal = goal;
+        result.totalSavings = best[goal];
+        if (!taken.empty())
+            selectFromSavingsMatrix(items.data(), n, best[goal], taken, result.selected);
+        else
+            selectFewestEntries(items.data(), items.data() + n, best[goal], result.selected);
+        result.entryCount = result.selected.size();
+    }
+    return answers[goal] = result;
+}
+
+// One index per process, rebuilt only when the ledger changes or a goal outgrows it; callers
+// that know several goals up front ask for the largest first.
+const SavingsIndex &savingsIndexFor(const Ledger &ledger, int goal)
+{
+    static SavingsIndex index;
+    if (!index.covers(ledger, goal))
+        index.build(ledger, goal);
+    return index;
+}
+
+SavingsResult optimizeSavings(const Ledger &ledger, int goal)
+{
+    return savingsIndexFor(ledger, goal).query(goal);
+}
+
+// ways[j] counts the subsets of non-essential amounts summing to j, modulo a 61-bit prime.
+// Adding an item is a shift-or of the reach bitset plus ways[j] += ways[j - a] from high to
+// low; removing one undoes that from low to high and clears the bit of every sum whose count
+// drops to 0, so both directions stay O(goal). A reachable sum whose subset count happens to
+// be a nonzero multiple of p is dropped as unreachable; that is about a 2^-61 chance per sum,
+// the usual risk of counting modulo a prime, and the next rebuild restores it.
+void SavingsReach::build(const Ledger &ledger, int goal)
+{
+    version = ledger.version;
+    maxGoal = goal;
+    items = 0;
+    ways.assign((size_t)goal + 1, 0);
+    ways[0] = 1;
+    reach.assign((size_t)goal / 64 + 1, 0);
+    reach[0] = 1;
+    for (const SavingsItem &item : collectNonEssentialExpenses(ledger))
+    {
+        if (item.amount > 0)
+            insert(item.amount);
+    }
+}
+
+void SavingsReach::insert(int amount)
+{
+    items++;
+    if (amount > maxGoal)
+        return;
+    for (int j = maxGoal; j >= amount; j--)
+    {
+        uint64_t sum = ways[j] + ways[j - amount];
+        ways[j] = sum >= SAVINGS_WAYS_PRIME ? sum - SAVINGS_WAYS_PRIME : sum;
+    }
+    subsetSumKernel().shiftOr(reach.data(), reach.size(), amount);
+}
+
+void SavingsReach::erase(int amount)
+{
+    items--;
+    if (amount > maxGoal)
+        return;
+    for (int j = amount; j <= maxGoal; j++)
+    {
+        uint64_t removed = ways[j - amount];
+        ways[j] = ways[j] >= removed ? ways[j] - removed : ways[j] + SAVINGS_WAYS_PRIME - removed;
+        if (ways[j] == 0)
+            reach[j >> 6] &= ~(1ULL << (j & 63));
+    }
+}
+
+int SavingsReach::best(int goal) const
+{
+    return highestReachable(reach, min(goal, maxGoal));
+}
+
+// The ledger owns its reach structure so setAmount keeps it current; it is rebuilt only when
+// the ledger changed some other way or the goal outgrew it.
+const SavingsReach &savingsReachFor(Ledger &ledger, int goal)
+{
+    SavingsReach &reach = ledger.savingsReach.obtain();
+    if (!reach.covers(ledger, goal))
+        reach.build(ledger, goal);
+    return reach;
+}
+
+vector<PaymentResult> optimizeCreditCardPayments(const Ledger &ledger, vector<CreditCard> &cardVec, int availableFunds)
+{
+    vector<int> totalDue(4, 0);
+    int dayCount = ledger.dayCount();
+    for (int c = 0; c < ledger.categoryCount; ++c)
+    {
+        const int *amounts = ledger.amountColumn(c);
+        const int *cards = ledger.cardColumn(c);
+        for (int d = 0; d < dayCount; ++d)
+        {
+            int cardIdx = cards[d];
+            if (cardIdx >= 1 && cardIdx <= 3)
+            {
+                totalDue[cardIdx] += amounts[d];
+            }
+        }
+    }
+    vector<int> amountPaid(4, 0);
+    for (int i = 1; i <= 3; ++i)
+    {
+        int minDue = cardVec[i].minDue;
+        int pay = min(minDue, totalDue[i]);
+        if (availableFunds >= pay)
+        {
+            amountPaid[i] += pay;
+            availableFunds -= pay;
+        }
+    }
+    vector<pair<int, double>> sortedCards;
+    for (int i = 1; i <= 3; ++i)
+    {
+        int unpaid = totalDue[i] - amountPaid[i];
+        if (unpaid > 0)
+        {
+            sortedCards.push_back(make_pair(i, cardVec[i].interestRate));
+        }
+    }
+    sort(sortedCards.begin(), sortedCards.end(), [](const pair<int, double> &a, const pair<int, double> &b)
+         { return a.second > b.second; });
+    for (size_t i = 0; i < sortedCards.size(); ++i)
+    {
+        int idx = sortedCards[i].first;
+        double rate = sortedCards[i].second;
+        int unpaid = totalDue[idx] - amountPaid[idx];
+        int pay = min(unpaid, availableFunds);
+        amountPaid[idx] += pay;
+        availableFunds -= pay;
+        if (availableFunds == 0)
+            break;
+    }
+    vector<PaymentResult> results;
+    for (int i = 1; i <= 3; ++i)
+    {
+        int unpaid = totalDue[i] - amountPaid[i];
+        double interest = unpaid * cardVec[i].interestRate / 100.0;
+        results.push_back({cardVec[i].name, totalDue[i], amountPaid[i], unpaid, interest});
+    }
+    sort(results.begin(), results.end(), [&](const PaymentResult &a, const PaymentResult &b)
+         {
+        int ai = a.card[0] - 'A' + 1;int bi = b.card[0] - 'A' + 1;
+        return cardVec[ai].interestRate > cardVec[bi].interestRate; });
+    return results;
+}
+
+void displayResults(const vector<PaymentResult> &results)
+{
+    cout << "+-----------+------------+-----------+-----------+-------------------+" << endl;
+    cout << left
+         << "| " << setw(10) << "Card"
+         << "| " << setw(11) << "Total Due"
+         << "| " << setw(10) << "Paid"
+         << "| " << setw(10) << "Unpaid"
+         << "| " << setw(18) << "Interest Incurred"
+         << "|" << endl;
+    cout << "+-----------+------------+-----------+-----------+-------------------+" << endl;
+    for (const auto &r : results)
+    {
+        cout << left
+             << "| " << setw(10) << r.card
+             << "| " << setw(11) << fixed << setprecision(2) << r.totalDue
+             << "| " << setw(10) << r.amountPaid
+             << "| " << setw(10) << r.unpaidAmount
+             << "| " << setw(18) << ("Rs. " + to_string(r.interest))
+             << "|" << endl;
+    }
+    cout << "+-----------+------------+-----------+-----------+-------------------+" << endl;
+}
+
+int findMinTravelCost(
+    const vector<City> &cities, const vector<vector<ERoute>> &graph, int source, int destination, int numPeople, int numDays, vector<int> &parent)
+{
+    int n = cities.size();
+    vector<int> minCost(n, numeric_limits<int>::max());
+    priority_queue<CNode, vector<CNode>, greater<CNode>> pq;
+    parent.assign(n, -1);
+    minCost[source] = cities[source].hotelCostPerNight * numDays * numPeople;
+    pq.push({source, minCost[source]});
+    while (!pq.empty())
+    {
+        CNode current = pq.top();
+        pq.pop();
+        for (const ERoute &edge : graph[current.city])
+        {
+            int newCost = current.cost + edge.flightCost * numPeople + cities[edge.destination].hotelCostPerNight * numDays * numPeople;
+            if (newCost < minCost[edge.destination])
+            {
+                minCost[edge.destination] = newCost;
+                parent[edge.destination] = current.city;
+                pq.push({edge.destination, newCost});
+            }
+        }
+    }
+    return minCost[destination];
+}
+
+vector<string> travelPath(const vector<int> &parent, int source, int destination, const vector<City> &cities)
+{
+    vector<string> path;
+    int current = destination;
+    while (current != -1)
+    {
+        path.push_back(cities[current].name);
+        if (current == source)
+            break;
+        current = parent[current];
+    }
+    if (path.back() != cities[source].name)
+        return {};
+    reverse(path.begin(), path.end());
+    return path;
+}
+
+void printPath(const vector<int> &parent, int source, int destination, const vector<City> &cities)
+{
+    vector<string> path = travelPath(parent, source, destination, cities);
+    if (path.empty())
+    {
+        cout << "No path exists from " << cities[source].name << " to " << cities[destination].name << ".\n";
+        return;
+    }
+    cout << "Cheapest path: ";
+    for (size_t i = 0; i < path.size(); ++i)
+    {
+        cout << path[i];
+        if (i != path.size() - 1)
+            cout << " -> ";
+    }
+    cout << endl;
+}
+
+void loadTravelNetwork(const string &networkFile, vector<City> &cities, vector<vector<ERoute>> &graph, unordered_map<string, int> &cityIndex)
+{
+    ifstream file(networkFile);
+    if (!file.is_open())
+        throw runtime_error("Cannot open travel network " + networkFile);
+    string line;
+    auto nextValue = [&]()
+    {
+        while (getline(file, line))
+        {
+            if (!line.empty() && line.back() == '\r')
+                line.pop_back();
+            if (!line.empty())
+                return line;
+        }
+        throw runtime_error("Unexpected end of travel network " + networkFile);
+    };
+    int numCities = stoi(nextValue());
+    cities.assign(numCities, City());
+    graph.assign(numCities, vector<ERoute>());
+    cityIndex.clear();
+    for (int i = 0; i < numCities; ++i)
+    {
+        cities[i].name = nextValue();
+        cities[i].hotelCostPerNight = stoi(nextValue());
+        cityIndex[cities[i].name] = i;
+    }
+    int numFlights = stoi(nextValue());
+    for (int i = 0; i < numFlights; ++i)
+    {
+        string from = nextValue();
+        string to = nextValue();
+        int cost = stoi(nextValue());
+        if (cityIndex.find(from) == cityIndex.end() || cityIndex.find(to) == cityIndex.end())
+            throw runtime_error("Unknown city in flight route " + from + " -> " + to);
+        graph[cityIndex[from]].push_back({cityIndex[to], cost});
+    }
+}
+
+void travelExpenseMinimizer()
+{
+    int numCities;
+    while (true)
+    {
+        cout << "Enter number of cities: ";
+        if (isValidIntInput(numCities) && numCities > 1)
+            break;
+        cout << "Invalid input. Number of cities must be greater than 1.\n";
+    }
+    vector<City> cities(numCities);
+    unordered_map<string, int> cityIndex;
+    cout << "\nEnter city names and hotel costs per night:\n";
+    for (int i = 0; i < numCities; ++i)
+    {
+        string cityName;
+        int hotelCost;
+        cout << "City " << i + 1 << " name: ";
+        cin >> ws;
+        getline(cin, cityName);
+        while (true)
+        {
+            cout << "Hotel cost per night in " << cityName << ": ";
+            if (isValidIntInput(hotelCost))
+                break;
+            cout << "Please enter a valid non-negative number for hotel cost.\n";
+        }
+        cities[i] = {cityName, hotelCost};
+        cityIndex[cityName] = i;
+    }
+    int numFlights;
+    while (true)
+    {
+        cout << "\nEnter number of flight routes: ";
+        if (isValidIntInput(numFlights) && numFlights >= 1)
+            break;
+        cout << "Enter at least 1 valid flight route.\n";
+    }
+    vector<vector<ERoute>> graph(numCities);
+    for (int i = 0; i < numFlights; ++i)
+    {
+        string from, to;
+        int cost;
+        cout << "\nFlight Route " << i + 1 << ":\n";
+        cout << "From city: ";
+        cin >> ws;
+        getline(cin, from);
+        cout << "To city: ";
+        getline(cin, to);
+        if (cityIndex.find(from) == cityIndex.end() || cityIndex.find(to) == cityIndex.end())
+        {
+            cout << " Invalid city names. Please re-enter this flight route.\n";
+            --i;
+            continue;
+        }
+        while (true)
+        {
+            cout << "Flight cost from " << from << " to " << to << ": ";
+            if (isValidIntInput(cost))
+                break;
+            cout << "Invalid cost. Please enter a non-negative number.\n";
+        }
+        graph[cityIndex[from]].push_back({cityIndex[to], cost});
+    }
+    string src, dest;
+    cout << "\nEnter starting city: ";
+    cin >> ws;
+    getline(cin, src);
+    cout << "Enter destination city: ";
+    getline(cin, dest);
+    if (cityIndex.find(src) == cityIndex.end() || cityIndex.find(dest) == cityIndex.end())
+    {
+        cout << "One or both cities are invalid.\n";
+        return;
+    }
+    int people;
+    while (true)
+    {
+        cout << "Enter number of travelers: ";
+        if (isValidIntInput(people) && people > 0)
+            break;
+        cout << "Invalid number. Please enter a positive value.\n";
+    }
+    int days;
+    while (true)
+    {
+        cout << "Enter number of days to stay in each city: ";
+        if (isValidIntInput(days) && days > 0)
+            break;
+        cout << "Please enter a positive number of days.\n";
+    }
+    vector<int> parent;
+    int totalCost = findMinTravelCost(cities, graph, cityIndex[src], cityIndex[dest], people, days, parent);
+    cout << "\nMinimum total cost from " << src << " to " << dest
+         << " for " << people << " traveler(s) over " << days << " day(s) is: Rs " << totalCost << endl;
+    printPath(parent, cityIndex[src], cityIndex[dest], cities);
+    cout << endl;
+    cout << endl;
+}
+
+void initializeDisjointSet(int n)
+{
+    parent.assign(n, 0);
+    rankArr.assign(n, 0);
+    for (int i = 0; i < n; ++i)
+    {
+        parent[i] = i;
+        rankArr[i] = 0;
+    }
+}
+
+int findParent(int x)
+{
+    if (parent[x] != x)
+        parent[x] = findParent(parent[x]);
+    return parent[x];
+}
+
+void unionSets(int x, int y)
+{
+    int rootX = findParent(x);
+    int rootY = findParent(y);
+    if (rootX != rootY)
+    {
+        if (rankArr[rootX] > rankArr[rootY])
+        {
+            parent[rootY] = rootX;
+        }
+        else if (rankArr[rootX] < rankArr[rootY])
+        {
+            parent[rootX] = rootY;
+        }
+        else
+        {
+            parent[rootY] = rootX;
+            rankArr[rootX]++;
+        }
+    }
+}
+
+// Stable, like the bubble sort it replaces, so Kruskal still breaks equal-weight ties in the
+// same order and the transfer plan is unchanged.
+void sortEdges(Edge edges[], int edgeCount)
+{
+    stable_sort(edges, edges + edgeCount, [](const Edge &a, const Edge &b)
+                { return a.weight < b.weight; });
+}
+
+void displayGraph(const Edge edges[], int count)
+{
+    cout << "\nGraph Edges:\n";
+    for (int i = 0; i < count; ++i)
+        cout << "Edge from " << edges[i].src << " to " << edges[i].dest << " with cost Rs. " << edges[i].weight << "\n";
+}
+
+EmergencyFundResult computeEmergencyFunds(const Ledger &ledger)
+{
+    EmergencyFundResult result;
+    int dayCount = ledger.dayCount();
+    result.dayTotals = ledger.dayTotals();
+    const vector<long long> &totals = result.dayTotals;
+    vector<Edge> edges;
+    for (int node = 0; node + 1 < dayCount; ++node)
+    {
+        double diff = llabs(totals[node] - totals[node + 1]);
+        edges.push_back({node, node + 1, diff});
+    }
+    int edgeCount = edges.size();
+    sortEdges(edges.data(), edgeCount);
+    initializeDisjointSet(dayCount);
+    for (int i = 0; i < edgeCount; ++i)
+    {
+        int u = edges[i].src, v = edges[i].dest;
+        if (findParent(u) != findParent(v))
+        {
+            unionSets(u, v);
+            result.totalCost += edges[i].weight;
+            result.transfers.push_back(edges[i]);
+        }
+    }
+    return result;
+}
+
+void allocateEmergencyFunds()
+{
+    const char *monthNames[] = {
+        "Jan", "Feb", "Mar", "Apr", "May", "Jun",
+        "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+    EmergencyFundResult result = computeEmergencyFunds(ledger);
+    const vector<long long> &totals = result.dayTotals;
+    auto label = [&](int day)
+    {
+        int year = 0, month = 0, dayOfMonth = 0;
+        ledger.dateOf(day).civil(year, month, dayOfMonth);
+        string text = ledger.yearCount > 1 ? to_string(year) + " " : "";
+        return text + monthNames[month - 1] + " " + to_string(dayOfMonth);
+    };
+    cout << "\nEmergency Fund Transfer Graph Constructed.\n";
+    for (auto &e : result.transfers)
+    {
+        if (e.weight > 0)
+        {
+            cout << label(e.src) << " ---> " << label(e.dest) << "\n"
+                 << "   - " << label(e.src) << " Expenses: Rs. " << totals[e.src] << "\n"
+                 << "   - " << label(e.dest) << " Expenses: Rs. " << totals[e.dest] << "\n"
+                 << "   - Difference (Transfer Need): Rs. " << e.weight << "\n\n";
+        }
+    }
+    cout << "\nTotal Minimum Transfer Cost: Rs. " << result.totalCost << "\n";
+    cout << "Summary:\n";
+    cout << "The function 'allocateEmergencyFunds' models daily expenses as a graph and applies Kruskal's algorithm (greedy algorithm) to minimize the cost of transferring emergency funds over time. "
+         << "It treats each day as a node and connects consecutive days with edges weighted by the absolute difference in expense totals. "
+         << "This resembles classic MST problems on LeetCode like 1135 (Connecting Cities With Minimum Cost) and applies greedy and union-find techniques. "
+         << "The time complexity is approximately O(E log E + N), where E is the number of edges and N is the number of nodes.\n\n";
+}
+
+void buildHuffmanTree(const string &data, unordered_map<char, string> &huffmanCode)
+{
+    unordered_map<char, int> freq;
+    for (char ch : data)
+        freq[ch]++;
+    priority_queue<HuffmanNode *, vector<HuffmanNode *>, Compare> pq;
+    for (auto &pair : freq)
+        pq.push(new HuffmanNode(pair.first, pair.second));
+    while (pq.size() > 1)
+    {
+        HuffmanNode *left = pq.top();
+        pq.pop();
+        HuffmanNode *right = pq.top();
+        pq.pop();
+        HuffmanNode *node = new HuffmanNode('\0', left->freq + right->freq);
+        node->left = left;
+        node->right = right;
+        pq.push(node);
+    }
+    function<void(HuffmanNode *, string)> encode = [&](HuffmanNode *node, string str)
+    {
+        if (!node)
+            return;
+        if (node->data != '\0')
+            huffmanCode[node->data] = str;
+        encode(node->left, str + "0");
+        encode(node->right, str + "1"); };
+    encode(pq.top(), "");
+}
+
+string compressData(const string &data, unordered_map<char, string> &huffmanCode)
+{
+    string compressed = "";
+    for (char ch : data)
+        compressed += huffmanCode[ch];
+    return compressed;
+}
+
+string decompressData(const string &compressed, unordered_map<char, string> &huffmanCode)
+{
+    unordered_map<string, char> reverseCode;
+    for (auto &pair : huffmanCode)
+        reverseCode[pair.second] = pair.first;
+    string temp = "", decompressed = "";
+    for (char bit : compressed)
+    {
+        temp += bit;
+        if (reverseCode.count(temp))
+        {
+            decompressed += reverseCode[temp];
+            temp = "";
+        }
+    }
+    return decompressed;
+}
+
+void updateExpenseData()
+{
+    string compressFile = "compress.csv";
+    string workingFile = (isValidFile(compressFile)) ? compressFile : filename;
+    ifstream file(workingFile);
+    stringstream buffer;
+    buffer << file.rdbuf();
+    string data = buffer.str();
+    file.close();
+    unordered_map<char, string> huffmanCode;
+    buildHuffmanTree(data, huffmanCode);
+    string compressed = compressData(data, huffmanCode);
+    ofstream outFile(compressFile);
+    outFile << huffmanCode.size() << '\n';
+    for (auto &pair : huffmanCode)
+        outFile << (int)(unsigned char)pair.first << ' ' << pair.second << '\n';
+    outFile << compressed;
+    outFile.close();
+    cout << "CSV data compressed to compress.csv!\n";
+    cout << "Summary:\n";
+    cout << "The function 'updateExpenseData' compresses CSV data using Huffman Encoding by building a frequency-based binary tree and replacing characters with shorter binary codes. "
+         << "It stores both the Huffman dictionary and the compressed bitstring to a new file. "
+         << "This is similar to LeetCode problems involving compression and encoding like 451 (Sort Characters by Frequency) and 271 (Encode and Decode Strings). "
+         << "The time complexity is O(n log n) due to the priority queue operations over n characters in the Huffman tree construction.\n\n";
+}
+
+void restoreExpenseData()
+{
+    string compressFile = "compress.csv";
+    string decompressFile = "decompress.csv";
+    if (!isValidFile(compressFile))
+    {
+        cout << "No compressed file found to decompress.\n";
+        return;
+    }
+    ifstream file(compressFile);
+    int mapSize;
+    file >> mapSize;
+    unordered_map<char, string> huffmanCode;
+    for (int i = 0; i < mapSize; ++i)
+    {
+        int chInt;
+        string code;
+        file >> chInt >> code;
+        huffmanCode[(char)chInt] = code;
+    }
+    file.ignore(); // skip the newline after header
+    string compressed;
+    getline(file, compressed, '\0');
+    file.close();
+    string decompressed = decompressData(compressed, huffmanCode);
+    ofstream outFile(decompressFile);
+    outFile << decompressed;
+    outFile.close();
+    cout << "Data restored from compress.csv to decompress.csv\n";
+    cout << "Summary:\n";
+    cout << "The function 'restoreExpenseData' reads a Huffman-encoded CSV file, reconstructs the encoding map, and decodes the binary string back into original text. "
+         << "It uses a reverse lookup on the binary codes and writes the decompressed result into a new file. "
+         << "This process is conceptually related to decoding problems like LeetCode 271 (Encode and Decode Strings) or 5 (Longest Palindromic Substring, in terms of parsing). "
+         << "The time complexity is O(n), where n is the number of bits in the compressed data.\n\n";
+}
+
+void loadExpenseData(map<string, double> &expenses)
+{
+    ifstream file(filename);
+    if (!file)
+    {
+        cout << "No previous expense data found." << endl;
+        return;
+    }
+    string category;
+    double amount;
+    while (file >> category >> amount)
+    {
+        expenses[category] += amount;
+    }
+    file.close();
+}
+
+void saveExpenseData(const map<string, double> &expenses)
+{
+    ofstream file(filename);
+    for (const auto &entry : expenses)
+    {
+        file << entry.first << " " << entry.second << endl;
+    }
+    file.close();
+}
+
+void listAllExpenses(const map<string, double> &expenses)
+{
+    cout << "All Expenses:\n";
+    for (const auto &entry : expenses)
+    {
+        cout << entry.first << ": " << entry.second << "\n";
+    }
+}
+
+vector<LoanRepaymentResult> optimizeLoanRepayment(const Ledger &ledger, int income, int year, int month, vector<Loan> &loans)
+{
+    long long totalSpent = ledger.monthTotal(year, month);
+    cout << "\n Total Spent: Rs." << totalSpent << endl;
+    cout << " Total Income: Rs." << income << endl;
+    int availableFunds = (int)max(0LL, income - totalSpent);
+    cout << " Available for Loan Repayment: Rs." << availableFunds << endl
+         << endl;
+    vector<pair<int, double>> loanPriority;
+    for (int i = 0; i < loans.size(); ++i)
+    {
+        double density = loans[i].interestRate / loans[i].amount;
+        loanPriority.push_back({i, density});
+    }
+    sort(loanPriority.begin(), loanPriority.end(), [](auto &a, auto &b)
+         { return a.second > b.second; });
+    vector<LoanRepaymentResult> results(loans.size());
+    for (int i = 0; i < loans.size(); ++i)
+    {
+        results[i] = {loans[i].id, loans[i].amount, 0.0, loans[i].amount, loans[i].amount * loans[i].interestRate / 100.0};
+    }
+    for (const auto &entry : loanPriority)
+    {
+        int idx = entry.first;
+        if (availableFunds <= 0)
+            break;
+        double pay = min(loans[idx].amount, (double)availableFunds);
+        results[idx].amountPaid = pay;
+        results[idx].unpaidAmount = loans[idx].amount - pay;
+        results[idx].interestIncurred = results[idx].unpaidAmount * loans[idx].interestRate / 100.0;
+        availableFunds -= pay;
+    }
+    return results;
+}
+
+void displayLoanResults(const vector<LoanRepaymentResult> &results)
+{
+    cout << "\nLoan Repayment Summary:\n";
+    cout << "+-----------+----------------+-----------+-----------+-------------------+" << endl;
+    cout << left
+         << "| " << setw(10) << "Loan ID"
+         << "| " << setw(15) << "Original (Rs.)"
+         << "| " << setw(10) << "Paid"
+         << "| " << setw(10) << "Unpaid"
+         << "| " << setw(18) << "Interest Incurred"
+         << "|" << endl;
+    cout << "+-----------+----------------+-----------+-----------+-------------------+" << endl;
+    for (const auto &r : results)
+    {
+        cout << left
+             << "| " << setw(10) << r.id
+             << "| " << setw(15) << fixed << setprecision(2) << r.originalAmount
+             << "| " << setw(10) << r.amountPaid
+             << "| " << setw(10) << r.unpaidAmount
+             << "| " << setw(18) << ("Rs. " + to_string(r.interestIncurred))
+             << "|" << endl;
+    }
+    cout << "+-----------+----------------+-----------+-----------+-------------------+" << endl;
+}
+
+void optimizeInvestmentPortfolio(int totalRiskBudget)
+{
+    vector<Investment> investments = {{101, 2000, 5000, 20}, {102, 100, 500, 10}, {103, 10000, 50000, 50}, {104, 100, 500, 10}, {105, 6000, 10000, 50}, {106, 2000, 10000, 20}, {107, 5000, 20000, 30}, {108, 1000, 5000, 15}, {109, 3000, 15000, 25}, {110, 4000, 20000, 40}};
+    sort(investments.begin(), investments.end(), [](const Investment &a, const Investment &b)
+         { return (a.returnPerUnit / a.riskPerUnit) > (b.returnPerUnit / b.riskPerUnit); });
+    double totalReturn = 0;
+    vector<pair<int, int>> selected;
+    for (const auto &inv : investments)
+    {
+        int maxUnitsWeCanTake = min(inv.maxUnits, totalRiskBudget / (int)inv.riskPerUnit);
+        if (maxUnitsWeCanTake >= 1)
+        {
+            int usedRisk = maxUnitsWeCanTake * inv.riskPerUnit;
+            totalRiskBudget -= usedRisk;
+            totalReturn += maxUnitsWeCanTake * inv.returnPerUnit;
+            selected.push_back({inv.id, maxUnitsWeCanTake});
+        }
+        if (totalRiskBudget <= 0)
+            break;
+    }
+    cout << "\nInvestment Portfolio Optimization:\n"
+         << endl;
+    cout << "+----------------+-------------------+--------------------+" << endl;
+    cout << left << "| " << setw(15) << "Investment ID" << "| " << setw(18) << "Units Selected"
+         << "| " << setw(19) << "Return (Rs.)" << "|" << endl;
+    cout << "+----------------+-------------------+--------------------+" << endl;
+    for (const auto &entry : selected)
+    {
+        int id = entry.first;
+        int units = entry.second;
+        double ret = units * investments[id % 100 - 1].returnPerUnit;
+        cout << left << "| " << setw(15) << id << "| " << setw(18) << units
+             << "| Rs. " << setw(15) << fixed << setprecision(2) << ret << "|" << endl;
+    }
+    cout << "+----------------+-------------------+--------------------+" << endl;
+    cout << "\nTotal Expected Return: Rs." << fixed << setprecision(2) << totalReturn << endl;
+}
+
+void generateBudgetPlan(double monthlyIncome)
+{
+    cout << fixed << setprecision(2);
+    cout << "\n Monthly Budget for Income: " << monthlyIncome << "\n"
+         << endl;
+    cout << " NEEDS (50%) - " << 0.50 * monthlyIncome << endl;
+    cout << "   Rent (30%): " << 0.30 * monthlyIncome << endl;
+    cout << "   Groceries (10%): " << 0.10 * monthlyIncome << endl;
+    cout << "   Utilities (5%): " << 0.05 * monthlyIncome << endl;
+    cout << "   Transportation (5%): " << 0.05 * monthlyIncome << endl;
+    cout << "\n WANTS (15%) - " << 0.15 * monthlyIncome << endl;
+    cout << "   Shopping + EMIs (10%): " << 0.10 * monthlyIncome << endl;
+    cout << "   Entertainment + Travel (5%): " << 0.05 * monthlyIncome << endl;
+    cout << "\n SAVINGS + INVESTMENTS (20%) - " << 0.20 * monthlyIncome << endl;
+    cout << "   Health + Term Insurance (5%): " << 0.05 * monthlyIncome << endl;
+    cout << "   SIP (in Mutual Funds) (10%): " << 0.10 * monthlyIncome << endl;
+    cout << "   Emergency Fund (5%): " << 0.05 * monthlyIncome << endl;
+    cout << "\n OTHERS (15%) - " << 0.15 * monthlyIncome << endl;
+    cout << "   Upskilling (5%): " << 0.05 * monthlyIncome << endl;
+    cout << "   Family Support (10%): " << 0.10 * monthlyIncome << endl;
+    cout << "\n TOTAL: " << monthlyIncome << " distributed across needs, wants, savings, and others.\n"
+         << endl;
+    cout << "Summary:\n";
+    cout << "The function 'generateBudgetPlan' categorizes a user's monthly income into Needs, Wants, Savings + Investments, and Others based on fixed percentages. "
+         << "It calculates and displays each category and sub-category with exact monetary allocations using standard financial budgeting principles. \n\n";
+}
+
+void encrypt(const string &inputFilename, const string &outputFilename, int key)
+{
+    ifstream input(inputFilename);
+    ofstream output(outputFilename);
+    if (!input.is_open() || !output.is_open())
+    {
+        cout << "Error opening files.\n";
+        return;
+    }
+    char ch;
+    while (input.get(ch))
+    {
+        if (isalpha(ch))
+        {
+            char base = islower(ch) ? 'a' : 'A';
+            ch = (ch - base + key) % 26 + base;
+        }
+        else if (isdigit(ch))
+        {
+            ch = (ch - '0' + key) % 10 + '0';
+        }
+        output.put(ch);
+    }
+    input.close();
+    output.close();
+    cout << "Encrypted " << inputFilename << "into " << outputFilename << endl;
+}
+
+void decrypt(const string &inputFilename, const string &outputFilename, int key)
+{
+    ifstream input(inputFilename);
+    ofstream output(outputFilename);
+    if (!input.is_open() || !output.is_open())
+    {
+        cout << "Error opening files.\n";
+        return;
+    }
+    char ch;
+    while (input.get(ch))
+    {
+        if (isalpha(ch))
+        {
+            char base = islower(ch) ? 'a' : 'A';
+            ch = ((ch - base - key) % 26 + 26) % 26 + base;
+        }
+        else if (isdigit(ch))
+        {
+            ch = ((ch - '0' - key) % 10 + 10) % 10 + '0';
+        }
+        output.put(ch);
+    }
+    input.close();
+    output.close();
+    cout << "Decrypted " << inputFilename << " into " << outputFilename << endl;
+}
+
+RentBuyResult rentVsBuyDecision(const RentBuyInput &input, double interestRate, double rentIncreaseRate)
+{
+    RentBuyResult result;
+    result.totalRentCost = 0;
+    double currentRent = input.rentCost;
+    for (int i = 0; i < input.yearsToOwnProperty; ++i)
+    {
+        result.totalRentCost += currentRent * 12;
+        currentRent *= (1 + rentIncreaseRate);
+    }
+    double remainingPrincipal = input.propertyCost;
+    double monthlyRate = interestRate / 12;
+    int months = 0;
+    double totalEmiPaid = 0;
+    while (remainingPrincipal > 0 && months < 1000 * 12)
+    {
+        double monthlyInterest = remainingPrincipal * monthlyRate;
+        double principalPaid = input.emi - monthlyInterest;
+        if (principalPaid <= 0)
+        {
+            result.totalBuyCost = -1;
+            result.yearsToOwnProperty = -1;
+            result.recommendation = "EMI too low to ever repay the loan.";
+            return result;
+        }
+        remainingPrincipal -= principalPaid;
+        totalEmiPaid += input.emi;
+        months++;
+    }
+    result.totalBuyCost = totalEmiPaid;
+    result.yearsToOwnProperty = (months + 11) / 12;
+    result.recommendation = (result.totalBuyCost < result.totalRentCost) ? "Buy" : "Rent";
+    return result;
+}
+
+InventoryResult optimizeInventory(const vector<Product> &products, int capacity)
+{
+    int n = products.size();
+    vector<vector<int>> dp(n + 1, vector<int>(capacity + 1, 0));
+    vector<vector<bool>> taken(n + 1, vector<bool>(capacity + 1, false));
+    for (int i = 1; i <= n; ++i)
+    {
+        const Product &p = products[i - 1];
+        for (int c = 0; c <= capacity; ++c)
+        {
+            dp[i][c] = dp[i - 1][c];
+            if (p.size <= c)
+            {
+                int newProfit = dp[i - 1][c - p.size] + p.profit;
+                if (newProfit > dp[i][c])
+                {
+                    dp[i][c] = newProfit;
+                    taken[i][c] = true;
+                }
+            }
+        }
+    }
+    InventoryResult result;
+    result.totalProfit = dp[n][capacity];
+    int c = capacity;
+    for (int i = n; i >= 1; --i)
+    {
+        if (taken[i][c])
+        {
+            result.selectedProductIndices.push_back(i - 1);
+            c -= products[i - 1].size;
+        }
+    }
+    return result;
+}
+
+SchedulerResult scheduleRecurringExpenses(const vector<RecurringBill> &bills, int income)
+{
+    vector<RecurringBill> sorted = bills;
+    sort(sorted.begin(), sorted.end(), [](const RecurringBill &a, const RecurringBill &b)
+         { return a.penalty > b.penalty; });
+    int remaining = income;
+    SchedulerResult result;
+    for (const auto &bill : sorted)
+    {
+        if (bill.amount <= remaining)
+        {
+            result.paymentSchedule.push_back("Paid: " + bill.name);
+            remaining -= bill.amount;
+        }
+        else
+        {
+            result.paymentSchedule.push_back("Unpaid: " + bill.name + " (Penalty: " + to_string(bill.penalty) + ")");
+            result.totalPenaltyPaid += bill.penalty;
+        }
+    }
+    return result;
+}
+
+void runRentVsBuySimulator()
+{
+    RentBuyInput input;
+    int year, month;
+    ledger.latestMonth(year, month);
+    double totalMonthlyExpenses = ledger.monthTotal(year, month);
+    cout << "Monthly expenses are taken from " << year << "-" << setw(2) << setfill('0') << month + 1 << setfill(' ')
+         << " (Rs. " << totalMonthlyExpenses << "), the latest month in the ledger.\n";
+    cout << "Enter monthly income: ";
+    if (!isValidDoubleInput(input.income))
+    {
+        cout << "Invalid amount entered! Please enter a correct income value.\n";
+        return;
+    }
+    if (input.income < totalMonthlyExpenses)
+    {
+        char proceed;
+        cout << "Your income is less than monthly expenses (" << totalMonthlyExpenses << "). Do you want to proceed further? (y/n): ";
+        cin >> proceed;
+        if (proceed != 'y' && proceed != 'Y')
+        {
+            cout << "Exiting as per your choice.\n";
+            return;
+        }
+    }
+    cout << "Enter monthly rent cost: ";
+    if (!isValidDoubleInput(input.rentCost))
+    {
+        cout << "Invalid amount entered! Please enter a valid rent cost.\n";
+        return;
+    }
+    double savings = input.income - totalMonthlyExpenses;
+    if (input.rentCost < savings)
+    {
+        cout << " The rent is affordable, as it is less than your monthly savings (Rs. " << fixed << setprecision(2) << savings << ").\n";
+    }
+    else
+    {
+        cout << " The rent might stretch your budget, as it exceeds your monthly savings.\n";
+    }
+    cout << "Enter home loan EMI: ";
+    if (!isValidDoubleInput(input.emi))
+    {
+        cout << "Invalid amount entered! Please enter a valid EMI value.\n";
+        return;
+    }
+    cout << "Enter total property cost: ";
+    if (!isValidDoubleInput(input.propertyCost))
+    {
+        cout << "Invalid amount entered! Please enter a valid property cost.\n";
+        return;
+    }
+    cout << "Enter years of stay: ";
+    if (!isValidIntInput(input.yearsToOwnProperty))
+    {
+        cout << "Invalid input! Please enter a valid year.\n";
+        return;
+    }
+    double emiInterestRate;
+    cout << "Enter home loan interest rate (e.g., 0.08 for 8%): ";
+    if (!isValidDoubleInput(emiInterestRate))
+    {
+        cout << "Invalid amount entered! Please enter a valid home loan interest rate.\n";
+        return;
+    }
+    double rentIncreaseRate;
+    cout << "Enter expected annual rent increase rate (e.g., 0.05 for 5%): ";
+    if (!isValidDoubleInput(rentIncreaseRate))
+    {
+        cout << "Invalid amount entered! Please enter a valid rent increase rate.\n";
+        return;
+    }
+    RentBuyResult result = rentVsBuyDecision(input, emiInterestRate, rentIncreaseRate);
+    cout << "\n--- Rent vs Buy Analysis ---\n";
+    cout << "Total cost if Renting (with yearly rent increase): Rs. " << fixed << setprecision(2) << result.totalRentCost << endl;
+    cout << "Total cost if Buying (with compound EMI): Rs. " << fixed << setprecision(2) << result.totalBuyCost << endl;
+    cout << "Years to own the property: " << fixed << setprecision(2) << result.yearsToOwnProperty << endl;
+    cout << "Recommendation: " << result.recommendation << endl;
+    pauseFor(2000);
+    cout << endl;
+}
+
+void runInventoryOptimizer()
+{
+    int capacity;
+    cout << "Enter warehouse capacity: ";
+    if (!isValidIntInput(capacity))
+    {
+        cout << "Invalid input! Please enter a valid capacity value.\n";
+        return;
+    }
+    const vector<Product> &products = defaultProducts;
+    InventoryResult result = optimizeInventory(products, capacity);
+    cout << "\n--- Inventory Optimization Result ---\n";
+    cout << "Max Profit: " << result.totalProfit << "\n";
+    cout << "Selected Products:\n";
+    cout << "ID\tSize\tProfit\n";
+    for (int idx : result.selectedProductIndices)
+    {
+        const Product &p = products[idx];
+        cout << "P" << idx + 1 << "\t" << p.size << "\t" << p.profit << "\n";
+    }
+    int usedCapacity = 0;
+    for (int idx : result.selectedProductIndices)
+        usedCapacity += products[idx].size;
+    cout << "Used Capacity: " << usedCapacity << " / " << capacity << endl;
+    pauseFor(2000);
+    cout << endl;
+}
+
+void runRecurringExpenseScheduler()
+{
+    int income;
+    cout << "Enter your monthly income: ";
+    if (!isValidIntInput(income) || income <= 0)
+    {
+        cout << "Invalid input! Please enter a positive integer for income.\n";
+        return;
+    }
+    int month;
+    cout << "Enter month number (1-12): ";
+    if (!isValidIntInput(month) || month < 1 || month > 12)
+    {
+        cout << "Invalid month! Please enter a number between 1 and 12.\n";
+        return;
+    }
+    int year = ledger.latestYearOf(month - 1);
+    double totalMonthExpenses = ledger.monthTotal(year, month - 1);
+    double availableIncome = income - totalMonthExpenses;
+    cout << "Total expenses for month " << month << " of " << year << ": " << totalMonthExpenses << endl;
+    cout << "Available income after expenses: " << availableIncome << endl;
+    if (availableIncome <= 0)
+    {
+        cout << "Warning: You have no disposable income for scheduling bills.\n";
+        return;
+    }
+    SchedulerResult result = scheduleRecurringExpenses(defaultRecurringBills, static_cast<int>(availableIncome));
+    cout << "\n--- Recurring Expense Schedule ---\n";
+    for (const string &entry : result.paymentSchedule)
+    {
+        cout << entry << endl;
+    }
+    cout << "Total Penalty Paid: Rs." << result.totalPenaltyPaid << endl;
+    pauseFor(2000);
+}
+
+void menu()
+{
+    int choice;
+    while (true)
+    {
+        try
+        {
+            cout << "\nExpense Tracker Menu:";
+            cout << "\n1. Display Expenses";
+            cout << "\n2. Add Expense";
+            cout << "\n3. Update Expense";
+            cout << "\n4. Delete Expense";
+            cout << "\n5. Design A budget plan";
+            cout << "\n6. Allocate Emergency Funds";
+            cout << "\n7. Compress Data";
+            cout << "\n8. Decompress Data";
+            cout << "\n9. Optimize Savings";
+            cout << "\n10. Credit Card Payment Strategy";
+            cout << "\n11. Best Flight optimization";
+            cout << "\n12. Loan Repayment Strategy";
+            cout << "\n13. Investment Portfolio Optimization";
+            cout << "\n14. Encrypt CSV";
+            cout << "\n15. Decrypt CSV";
+            cout << "\n16. Rent vs Buy";
+            cout << "\n17. Inventory Optimizer";
+            cout << "\n18. Recurring Expense Scheduler";
+            cout << "\n19. Exit";
+            cout << "\nEnter your choice: ";
+            cin >> choice;
+            if (cin.fail())
+            {
+                throw invalid_argument("Input must be an integer.");
+            }
+            if (choice < 1 || choice > 19)
+            {
+                throw out_of_range("Choice must be between 1 and 16.");
+            }
+            string filename = "OctExpenses.csv";
+            string filename2 = "carddetails.csv";
+            string date;
+            vector<CreditCard> cardVec = defaultCreditCards;
+            vector<PaymentResult> payVec;
+            vector<Loan> loans = defaultLoans;
+            vector<LoanRepaymentResult> payVecLoan;
+            vector<Investment> investments;
+            vector<InvestmentSelection> result;
+            switch (choice)
+            {
+            case 1:
+                displayExpenses();
+                pauseFor(2000);
+                break;
+            case 2:
+                addExpense();
+                break;
+            case 3:
+                updateExpense();
+                break;
+            case 4:
+                displayExpenses();
+                cout << "Enter the date (YYYY-MM-DD) to delete all expenses of that day: ";
+                cin >> date;
+                if (!Date::isWellFormed(date.data(), date.size()))
+                {
+                    cout << "Invalid date format! Please enter in YYYY-MM-DD format.\n";
+                    break;
+                }
+                if (deleteExpenses(date))
+                {
+                    displayExpenses();
+                    cout << "Summary:\n";
+                    cout << "The function `deleteExpenses` removes all expense data for a specified date from memory and records the deletion in the ledger journal. "
+                         << "It first parses the date, validates it, clears the corresponding in-memory entries, then appends the clearing adjustments and a clear-day record to the journal as one batch instead of rewriting the CSV. "
+                         << "This resembles LeetCode file-handling or string-parsing problems like 'Delete Operation for Two Strings'. "
+                         << "It uses topics like file I/O, error handling, date parsing, and string manipulation. Time complexity is O(k), where k is the number of categories.\n\n";
+                    pauseFor(2000);
+                }
+                else
+                {
+                    cout << "No expenses found for the entered date.\n";
+                }
+                break;
+            case 5:
+            {
+                double income;
+                cout << "Enter your monthly income in Rupees: ";
+                cin >> income;
+                if (cin.fail() || income <= 0)
+                {
+                    cin.clear();
+                    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                    cout << "Invalid income amount. Please enter a positive numeric value.\n";
+                    break;
+                }
+                cout << "\nGenerating your personalized budget plan...\n\n";
+                generateBudgetPlan(income);
+                pauseFor(5000);
+                break;
+            }
+            case 6:
+                allocateEmergencyFunds();
+                pauseFor(200);
+                break;
+            case 7:
+                updateExpenseData();
+                pauseFor(200);
+                break;
+            case 8:
+                restoreExpenseData();
+                pauseFor(200);
+                break;
+            case 9:
+            {
+                int goal;
+                while (true)
+                {
+                    cout << "Enter your target savings goal (in Rs): ";
+                    if (isValidIntInput(goal) && goal > 0)
+                        break;
+                    cout << "Invalid input. Please enter a **positive** numeric value for your goal.\n";
+                }
+                int excessAmount;
+                while (true)
+                {
                     cout << "\nWould you like to allow a small flexibility margin above your goal? (optional)\n";
                     cout << "Enter the extra amount you are willing to accept (Enter 0 if you want an exact match): ";
                     if (isValidIntInput(excessAmount))
@@ -1984,207 +4525,1257 @@ void menu(vector<int> &monthlyTotals)
                 cout << "  - Base Target Goal     : Rs. " << goal << endl;
                 cout << "  - Flexibility Allowed  : Rs. " << excessAmount << endl;
                 cout << "\nAttempting optimization for *Exact Goal (Rs. " << goal << ")*...\n";
-                optimizeSavings(goal);
+                const SavingsIndex &savings = savingsIndexFor(ledger, goal + max(0, excessAmount));
+                displaySavingsResult(savings.query(goal));
                 if (excessAmount > 0)
                     cout << "  - Extended Target Goal : Rs. " << goal + excessAmount << endl;
                 else
                     cout << "  - No flexibility allowed (exact goal only)\n";
                 if (excessAmount > 0)
                 {
-                    int finalGoal = goal + excessAmount;
-                    cout << "\nAttempting optimization for *Flexible Goal (Up to Rs. " << finalGoal << ")*...\n";
-                    optimizeSavings(finalGoal);
+                    int finalGoal = goal + excessAmount;
+                    cout << "\nAttempting optimization for *Flexible Goal (Up to Rs. " << finalGoal << ")*...\n";
+                    displaySavingsResult(savings.query(finalGoal));
+                }
+                cout << "Summary:\n";
+                cout << "The function identifies low-priority expenses that can be trimmed to meet savings goals with minimal disruption, \n"
+                     << "using a variation of the 0/1 Knapsack algorithm to maximize savings while minimizing the number of eliminated expenses.\n"
+                     << "This is similar to LeetCode Problem 416 ('Partition Equal Subset Sum') with the added constraint of minimizing the number of items used.\n"
+                     << "The O(N * G) table, where N is the number of expenses and G is the savings goal (treated as capacity), is built once per ledger version\n"
+                     << "for the larger goal. Each goal's entries are then listed in O(N) from that table, or, for goals too large to keep the table,\n"
+                     << "rebuilt once in O(N * G * log N) time and O(G) memory and remembered until the ledger changes.\n\n";
+                break;
+            }
+            case 10:
+            {
+                int funds;
+                while (true)
+                {
+                    cout << "Enter your available funds for credit card payments (in Rs): ";
+                    if (isValidIntInput(funds))
+                        break;
+                    cout << "Invalid input. Please enter a non-negative numeric value.\n";
+                }
+                vector<PaymentResult> payVec = optimizeCreditCardPayments(ledger, cardVec, funds);
+                displayResults(payVec);
+                double maxInterest = 0;
+                string maxCard;
+                for (const auto &r : payVec)
+                {
+                    if (r.interest > maxInterest)
+                    {
+                        maxInterest = r.interest;
+                        maxCard = r.card;
+                    }
+                }
+                if (maxInterest > 0)
+                {
+                    cout << "\nStrategy Suggestion: Prioritize clearing dues on card '" << maxCard
+                         << "' to reduce the highest incurred interest of Rs. " << fixed << setprecision(2) << maxInterest << ".\n";
+                }
+                else
+                {
+                    cout << "\nGreat job! All dues are covered  no interest will be incurred.\n";
+                }
+                cout << endl
+                     << endl;
+                cout << "Summary:\n";
+                cout << "The function optimizes credit card payments using a greedy approach by prioritizing low dues and high-interest cards,\n"
+                     << "allocating funds to minimize interest accumulation.\n"
+                     << "This is similar to LeetCode Problem 134 ('Gas Station') and strategies for debt repayment.\n"
+                     << "The time complexity is O(M * N + 3 log 3 + 3 log 3), where M is the number of months, and N is the number of days.\n\n";
+                break;
+            }
+            case 11:
+                travelExpenseMinimizer();
+                cout << "Summary:\n";
+                cout << "The function calculates the minimum travel cost using Dijkstra's algorithm, factoring in flight and hotel costs for a group. \n"
+                     << "It uses a greedy approach, prioritizing flights and hotel stays while ensuring optimal travel cost calculation.\n"
+                     << "This is similar to problems like LeetCode Problem 787, but extended to include hotel costs.\n"
+                     << "The time complexity is O(E x log V), where V is the number of cities and E is the number of flight routes.\n\n";
+                break;
+            case 12:
+                cout << "Enter your income: ";
+                int income1;
+                cin >> income1;
+                if (cin.fail())
+                {
+                    cin.clear();
+                    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                    cout << "Invalid input. Please enter a numeric value.\n";
+                    break;
+                }
+                if (income1 <= 0)
+                {
+                    cout << "Income must be a positive value.\n";
+                    break;
+                }
+                cout << "Enter the month number (1 for January, 12 for December): ";
+                int month;
+                cin >> month;
+                if (month < 1 || month > 12)
+                {
+                    cout << "Invalid month entered. Please enter a value between 1 and 12." << endl;
+                    break;
                 }
+                payVecLoan = optimizeLoanRepayment(ledger, income1, ledger.latestYearOf(month - 1), (month - 1), loans);
+                displayLoanResults(payVecLoan);
                 cout << "Summary:\n";
-                cout << "The function identifies low-priority expenses that can be trimmed to meet savings goals with minimal disruption, \n"
-                     << "using a variation of the 0/1 Knapsack algorithm to maximize savings while minimizing the number of eliminated expenses.\n"
-                     << "This is similar to LeetCode Problem 416 ('Partition Equal Subset Sum') with the added constraint of minimizing the number of items used.\n"
-                     << "The time complexity is O(N * G), where N is the number of expenses and G is the savings goal (treated as capacity).\n\n";
+                cout << "The function optimizes loan repayments using a greedy strategy by distributing leftover income after expenses to loans with the highest interest-to-amount ratio. "
+                     << "It ensures minimal interest accumulation by prioritizing high-density loans first. "
+                     << "This is similar to greedy problems like those on LeetCode (e.g., Candy or Queue Reconstruction). "
+                     << "The time complexity is O(m log m + 31n), where m is the number of loans.\n\n";
+                break;
+            case 13:
+                int riskBudget;
+                cout << "Enter your total risk budget: ";
+                cin >> riskBudget;
+                optimizeInvestmentPortfolio(riskBudget);
+                cout << "Summary:\n";
+                cout << "The function optimizes investment selections by using a greedy strategy to choose investments with the highest return-to-risk ratio within a given total risk budget. "
+                     << "It allocates the budget across available options to maximize total return, selecting as many units as allowed by the risk constraint. "
+                     << "This is conceptually similar to the Fractional Knapsack problem on LeetCode, where items with the highest value-to-weight ratio are prioritized. "
+                     << "The topics used include Greedy Algorithms and Sorting, and the time complexity is O(n log n), where n is the number of investments.\n\n";
+                break;
+            case 14:
+            {
+                int key;
+                cout << "Enter encryption key (positive integer): ";
+                cin >> key;
+                if (journal.records > 0)
+                    journal.compact(ledger, true);
+                encrypt(filename, "encrypted_Expenses.csv", key);
+                encrypt(filename2, "encrypted_carddetails.csv", key);
+                cout << "Summary:\n";
+                cout << "The function 'encrypt' reads a plaintext file and writes an encrypted version to another file using a Caesar cipher by shifting alphabetic and numeric characters forward by a key. "
+                     << "It maintains case sensitivity and handles wrap-around with modular arithmetic for both letters and digits. "
+                     << "This resembles LeetCode string manipulation problems like 1844 (Replace All Digits with Characters) or 709 (To Lower Case). "
+                     << "The time complexity is O(n), where n is the number of characters in the input file.\n\n";
+                pauseFor(200);
                 break;
             }
-            case 10:
+            case 15:
+            {
+                int key;
+                cout << "Enter decryption key (must match encryption key): ";
+                cin >> key;
+                decrypt("encrypted_Expenses.csv", "decrypted_Expenses.csv", key);
+                decrypt("encrypted_carddetails.csv", "decrypted_carddetails.csv", key);
+                cout << "Summary:\n";
+                cout << "The function 'decrypt' reads an encrypted file and writes the decrypted content to another file using a Caesar cipher reversal on letters and digits. "
+                     << "It preserves case and handles wrap-around with modular arithmetic for both alphabets and numbers. "
+                     << "This is similar to LeetCode problems involving string transformations, such as 2325 (Decode the Message) or 1528 (Shuffle String). "
+                     << "The time complexity is O(n), where n is the number of characters in the input file.\n\n";
+                pauseFor(200);
+                break;
+            }
+            case 16:
+                runRentVsBuySimulator();
+                cout << "Summary:\n";
+                cout << "The function evaluates whether renting or buying a property is financially smarter by comparing cumulative rent costs (with yearly hikes) against compounded EMI payments and maintenance using basic financial modeling. "
+                     << "It uses decision-making strategies using simulation and Financial Math modeling. "
+                     << "The time complexity is O(y) for y years of simulation, with additional O(1) compound interest math operations.\n\n";
+
+                pauseFor(3000);
+                break;
+            case 17:
+                runInventoryOptimizer();
+                cout << "Summary:\n";
+                cout << "The function optimizes inventory storage using a dynamic programming strategy, selecting products that maximize profit without exceeding warehouse capacity. "
+                     << "It reconstructs the selection path to determine which products were included in the optimal solution. "
+                     << "This mirrors classic 0/1 Knapsack problems on LeetCode (e.g., '01 Knapsack' or 'Partition Equal Subset Sum'). "
+                     << "The time complexity is O(n * capacity), where n is the number of products.\n\n";
+                pauseFor(3000);
+                break;
+            case 18:
+                runRecurringExpenseScheduler();
+                cout << "Summary:\n";
+                cout << "The function schedules recurring expenses by first calculating disposable income after monthly expenses, then uses a greedy strategy to prioritize bill payments based on penalty severity. "
+                     << "It ensures that the most financially damaging bills are paid first when income is limited, reducing total penalties. "
+                     << "This problem resembles greedy selection problems like LeetCode's 'Task Scheduler' or 'IPO', where maximum gain or minimum loss is prioritized under constraints. "
+                     << "The key topics include Greedy Algorithms, Sorting, and Budgeting Simulation. Time complexity is O(n log n), where n is the number of bills.\n\n";
+                pauseFor(3000);
+                break;
+            case 19:
+                cout << "Exiting program...\n";
+                return;
+            }
+        }
+        catch (const exception &e)
+        {
+            cin.clear();
+            cin.ignore(numeric_limits<streamsize>::max(), '\n');
+            cout << "Error: " << e.what() << "\nPlease try again.\n";
+        }
+    }
+}
+
+void displayHeader()
+{
+    cout << "****************************************************************" << endl;
+    cout << "*                      WELCOME TO OUR                          *" << endl;
+    cout << "*         Wealthwise: Algorithmic Financial Supervisor         *" << endl;
+    cout << "*                                                              *" << endl;
+    cout << "* Submitted to:                                 Programmed by: *" << endl;
+    cout << "* Dr. Suma Dawn                                          Rishu *" << endl;
+    cout << "* Mr. Tarun Agrawal                               Swayam Gupta *" << endl;
+    cout << "* Mr. Rohit Kumar Sony                            Maanya Gupta *" << endl;
+    cout << "*                                              Priyanshu Rawat *" << endl;
+    cout << "*                                                              *" << endl;
+    cout << "****************************************************************" << "\n"
+         << endl;
+}
+
+string jsonString(const string &text)
+{
+    string escaped = "\"";
+    for (unsigned char ch : text)
+    {
+        if (ch == '"' || ch == '\\')
+        {
+            escaped += '\\';
+            escaped += ch;
+        }
+        else if (ch < 0x20)
+        {
+            char buffer[8];
+            snprintf(buffer, sizeof(buffer), "\\u%04x", ch);
+            escaped += buffer;
+        }
+        else
+            escaped += ch;
+    }
+    return escaped + "\"";
+}
+
+vector<string> splitCommandLine(const string &line)
+{
+    vector<string> tokens;
+    string token;
+    bool inToken = false, quoted = false;
+    for (char ch : line)
+    {
+        if (ch == '"')
+        {
+            quoted = !quoted;
+            inToken = true;
+        }
+        else if (!quoted && isspace((unsigned char)ch))
+        {
+            if (inToken)
+                tokens.push_back(token);
+            token.clear();
+            inToken = false;
+        }
+        else
+        {
+            token += ch;
+            inToken = true;
+        }
+    }
+    if (quoted)
+        throw invalid_argument("Unterminated quote");
+    if (inToken)
+        tokens.push_back(token);
+    return tokens;
+}
+
+BatchCommand parseBatchCommand(const vector<string> &tokens, int line)
+{
+    BatchCommand command;
+    command.line = line;
+    command.name = tokens[0];
+    for (size_t i = 1; i < tokens.size(); i += 2)
+    {
+        if (tokens[i].compare(0, 2, "--") != 0 || tokens[i].size() == 2)
+            throw invalid_argument("Unexpected argument '" + tokens[i] + "' for " + command.name);
+        if (i + 1 >= tokens.size())
+            throw invalid_argument("Missing value for " + tokens[i]);
+        command.options[tokens[i].substr(2)] = tokens[i + 1];
+    }
+    return command;
+}
+
+string batchStringOption(const BatchCommand &command, const string &name, const string &fallback, bool required)
+{
+    auto it = command.options.find(name);
+    if (it != command.options.end())
+        return it->second;
+    if (required)
+        throw invalid_argument("Missing --" + name + " for " + command.name);
+    return fallback;
+}
+
+int batchIntOption(const BatchCommand &command, const string &name, int fallback, bool required)
+{
+    auto it = command.options.find(name);
+    if (it == command.options.end())
+    {
+        if (required)
+            throw invalid_argument("Missing --" + name + " for " + command.name);
+        return fallback;
+    }
+    const string &text = it->second;
+    int value = 0;
+    auto parsed = from_chars(text.data(), text.data() + text.size(), value);
+    if (parsed.ec != errc() || parsed.ptr != text.data() + text.size())
+        throw invalid_argument("--" + name + " must be an integer");
+    return value;
+}
+
+double batchDoubleOption(const BatchCommand &command, const string &name, double fallback, bool required)
+{
+    auto it = command.options.find(name);
+    if (it == command.options.end())
+    {
+        if (required)
+            throw invalid_argument("Missing --" + name + " for " + command.name);
+        return fallback;
+    }
+    const string &text = it->second;
+    double value = 0;
+    auto parsed = from_chars(text.data(), text.data() + text.size(), value);
+    if (parsed.ec != errc() || parsed.ptr != text.data() + text.size())
+        throw invalid_argument("--" + name + " must be a number");
+    return value;
+}
+
+string runBatchCommand(const BatchCommand &command)
+{
+    ostringstream json;
+    json << fixed << setprecision(2);
+    const string &name = command.name;
+    if (name == "savings")
+    {
+        int goal = batchIntOption(command, "goal", 0, true);
+        if (goal <= 0)
+            throw out_of_range("--goal must be positive");
+        SavingsResult result = optimizeSavings(ledger, goal);
+        json << "{\"goal\":" << goal << ",\"savings\":" << result.totalSavings
+             << ",\"entries\":" << result.entryCount << ",\"selected\":[";
+        for (size_t i = 0; i < result.selected.size(); ++i)
+        {
+            const SavingsItem &entry = result.selected[i];
+            json << (i ? "," : "") << "{\"amount\":" << entry.amount << ",\"date\":\"" << entry.date.toString().substr(5)
+                 << "\",\"category\":" << jsonString(categoryName(entry.category)) << "}";
+        }
+        json << "]}";
+    }
+    else if (name == "potential")
+    {
+        int goal = batchIntOption(command, "goal", 0, true);
+        if (goal <= 0)
+            throw out_of_range("--goal must be positive");
+        bool current = ledger.savingsReach.get() && ledger.savingsReach.get()->covers(ledger, goal);
+        const SavingsReach &reach = savingsReachFor(ledger, goal);
+        json << "{\"goal\":" << goal << ",\"savings\":" << reach.best(goal) << ",\"items\":" << reach.items
+             << ",\"rebuilt\":" << (current ? "false" : "true") << "}";
+    }
+    else if (name == "fraud")
+    {
+        RollingDetectorOptions rolling = ledger.rolling;
+        rolling.window = batchIntOption(command, "window", rolling.window);
+        rolling.multiplier = batchDoubleOption(command, "multiplier", rolling.multiplier);
+        rolling.minSamples = batchIntOption(command, "min-samples", rolling.minSamples);
+        vector<FraudAlert> flagged, rollingFlagged;
+        FraudAlertStream stream;
+        stream.callbacks.push_back([&](const FraudAlert &alert)
+                                   { (alert.window > 0 ? rollingFlagged : flagged).push_back(alert); });
+        publishThresholdAlerts(ledger, stream);
+        publishRollingAlerts(ledger, rolling, stream);
+        auto byDay = [](const FraudAlert &a, const FraudAlert &b)
+        { return a.day < b.day; };
+        stable_sort(flagged.begin(), flagged.end(), byDay);
+        stable_sort(rollingFlagged.begin(), rollingFlagged.end(), byDay);
+        json << "{\"flagged\":[";
+        for (size_t i = 0; i < flagged.size(); ++i)
+            json << (i ? "," : "") << fraudAlertJson(ledger, flagged[i]);
+        json << "],\"window\":" << rolling.window << ",\"cardSpikes\":[";
+        for (size_t i = 0; i < rollingFlagged.size(); ++i)
+            json << (i ? "," : "") << fraudAlertJson(ledger, rollingFlagged[i]);
+        json << "]}";
+    }
+    else if (name == "range")
+    {
+        int bounds[2];
+        const char *options[2] = {"from", "to"};
+        for (int i = 0; i < 2; i++)
+        {
+            string date = batchStringOption(command, options[i], "", true);
+            Date parsed;
+            if (!Date::parse(date, parsed))
+                throw invalid_argument(string("--") + options[i] + " must be a YYYY-MM-DD date");
+            bounds[i] = ledger.clampDay(parsed + i);
+        }
+        string category = batchStringOption(command, "category", "");
+        int only = category.empty() ? -1 : ledger.findCategory(category);
+        if (!category.empty() && only < 0)
+            throw invalid_argument("Unknown category " + category);
+        long long total = 0;
+        json << "{\"from\":" << jsonString(batchStringOption(command, "from", "")) << ",\"to\":" << jsonString(batchStringOption(command, "to", ""))
+             << ",\"categories\":[";
+        for (int c = 0, shown = 0; c < ledger.categoryCount; ++c)
+        {
+            if (only >= 0 && c != only)
+                continue;
+            long long sum = bounds[0] < bounds[1] ? ledger.rangeTotal(c, bounds[0], bounds[1]) : 0;
+            total += sum;
+            json << (shown++ ? "," : "") << "{\"category\":" << jsonString(categoryName(c)) << ",\"total\":" << sum << "}";
+        }
+        json << "],\"total\":" << total << "}";
+    }
+    else if (name == "stats")
+    {
+        json << "{\"categories\":[";
+        for (int c = 0; c < ledger.categoryCount; ++c)
+        {
+            const CategoryStats &columnStats = ledger.stats[c];
+            json << (c ? "," : "") << "{\"category\":" << jsonString(categoryName(c)) << ",\"essential\":" << (ledger.essential[c] ? "true" : "false")
+                 << ",\"count\":" << columnStats.count << ",\"mean\":" << columnStats.mean << ",\"stddev\":" << columnStats.stddev()
+                 << ",\"threshold\":" << columnStats.threshold() << "}";
+        }
+        json << "]}";
+    }
+    else if (name == "cards")
+    {
+        int funds = batchIntOption(command, "funds", 0, true);
+        if (funds < 0)
+            throw out_of_range("--funds must be non-negative");
+        vector<CreditCard> cardVec = defaultCreditCards;
+        vector<PaymentResult> results = optimizeCreditCardPayments(ledger, cardVec, funds);
+        json << "{\"funds\":" << funds << ",\"cards\":[";
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            const PaymentResult &r = results[i];
+            json << (i ? "," : "") << "{\"card\":" << jsonString(r.card) << ",\"totalDue\":" << r.totalDue << ",\"paid\":" << r.amountPaid
+                 << ",\"unpaid\":" << r.unpaidAmount << ",\"interest\":" << r.interest << "}";
+        }
+        json << "]}";
+    }
+    else if (name == "travel")
+    {
+        string from = batchStringOption(command, "from", "", true);
+        string to = batchStringOption(command, "to", "", true);
+        int people = batchIntOption(command, "people", 1);
+        int days = batchIntOption(command, "days", 1);
+        if (people <= 0 || days <= 0)
+            throw out_of_range("--people and --days must be positive");
+        vector<City> cities;
+        vector<vector<ERoute>> graph;
+        unordered_map<string, int> cityIndex;
+        loadTravelNetwork(batchStringOption(command, "network", travelNetworkFilename), cities, graph, cityIndex);
+        if (cityIndex.find(from) == cityIndex.end() || cityIndex.find(to) == cityIndex.end())
+            throw invalid_argument("One or both cities are invalid.");
+        vector<int> parent;
+        TravelResult result;
+        int cost = findMinTravelCost(cities, graph, cityIndex[from], cityIndex[to], people, days, parent);
+        if (cost != numeric_limits<int>::max())
+        {
+            result.totalCost = cost;
+            result.path = travelPath(parent, cityIndex[from], cityIndex[to], cities);
+        }
+        json << "{\"from\":" << jsonString(from) << ",\"to\":" << jsonString(to) << ",\"people\":" << people << ",\"days\":" << days
+             << ",\"reachable\":" << (result.path.empty() ? "false" : "true") << ",\"cost\":" << result.totalCost << ",\"path\":[";
+        for (size_t i = 0; i < result.path.size(); ++i)
+            json << (i ? "," : "") << jsonString(result.path[i]);
+        json << "]}";
+    }
+    else if (name == "loans")
+    {
+        int income = batchIntOption(command, "income", 0, true);
+        int month = batchIntOption(command, "month", 0, true);
+        if (income <= 0)
+            throw out_of_range("--income must be positive");
+        if (month < 1 || month > 12)
+            throw out_of_range("--month must be between 1 and 12");
+        int year = batchIntOption(command, "year", ledger.latestYearOf(month - 1));
+        vector<Loan> loans = defaultLoans;
+        vector<LoanRepaymentResult> results = optimizeLoanRepayment(ledger, income, year, month - 1, loans);
+        json << "{\"income\":" << income << ",\"year\":" << year << ",\"month\":" << month << ",\"loans\":[";
+        for (size_t i = 0; i < results.size(); ++i)
+        {
+            const LoanRepaymentResult &r = results[i];
+            json << (i ? "," : "") << "{\"id\":" << r.id << ",\"original\":" << r.originalAmount << ",\"paid\":" << r.amountPaid
+                 << ",\"unpaid\":" << r.unpaidAmount << ",\"interest\":" << r.interestIncurred << "}";
+        }
+        json << "]}";
+    }
+    else if (name == "emergency")
+    {
+        EmergencyFundResult result = computeEmergencyFunds(ledger);
+        int transfers = 0;
+        for (const Edge &e : result.transfers)
+        {
+            if (e.weight > 0)
+                transfers++;
+        }
+        json << "{\"transfers\":" << transfers << ",\"totalCost\":" << result.totalCost << "}";
+    }
+    else if (name == "rentbuy")
+    {
+        RentBuyInput input;
+        input.income = batchDoubleOption(command, "income", 0);
+        input.rentCost = batchDoubleOption(command, "rent", 0, true);
+        input.emi = batchDoubleOption(command, "emi", 0, true);
+        input.propertyCost = batchDoubleOption(command, "property", 0, true);
+        input.yearsToOwnProperty = batchIntOption(command, "years", 0, true);
+        double interestRate = batchDoubleOption(command, "rate", 0, true);
+        double rentIncreaseRate = batchDoubleOption(command, "rent-increase", 0);
+        RentBuyResult result = rentVsBuyDecision(input, interestRate, rentIncreaseRate);
+        json << "{\"totalRentCost\":" << result.totalRentCost << ",\"totalBuyCost\":" << result.totalBuyCost
+             << ",\"yearsToOwnProperty\":" << result.yearsToOwnProperty << ",\"recommendation\":" << jsonString(result.recommendation) << "}";
+    }
+    else if (name == "inventory")
+    {
+        int capacity = batchIntOption(command, "capacity", 0, true);
+        if (capacity < 0)
+            throw out_of_range("--capacity must be non-negative");
+        InventoryResult result = optimizeInventory(defaultProducts, capacity);
+        json << "{\"capacity\":" << capacity << ",\"totalProfit\":" << result.totalProfit << ",\"products\":[";
+        for (size_t i = 0; i < result.selectedProductIndices.size(); ++i)
+            json << (i ? "," : "") << "\"P" << result.selectedProductIndices[i] + 1 << "\"";
+        json << "]}";
+    }
+    else if (name == "recurring")
+    {
+        int income = batchIntOption(command, "income", 0, true);
+        int month = batchIntOption(command, "month", 0, true);
+        if (income <= 0)
+            throw out_of_range("--income must be positive");
+        if (month < 1 || month > 12)
+            throw out_of_range("--month must be between 1 and 12");
+        int year = batchIntOption(command, "year", ledger.latestYearOf(month - 1));
+        long long monthExpenses = ledger.monthTotal(year, month - 1);
+        long long availableIncome = income - monthExpenses;
+        SchedulerResult result;
+        if (availableIncome > 0)
+            result = scheduleRecurringExpenses(defaultRecurringBills, (int)availableIncome);
+        json << "{\"year\":" << year << ",\"monthExpenses\":" << monthExpenses << ",\"availableIncome\":" << availableIncome << ",\"schedule\":[";
+        for (size_t i = 0; i < result.paymentSchedule.size(); ++i)
+            json << (i ? "," : "") << jsonString(result.paymentSchedule[i]);
+        json << "],\"totalPenaltyPaid\":" << result.totalPenaltyPaid << "}";
+    }
+    else if (name == "edit")
+    {
+        string file = batchStringOption(command, "file", "", true);
+        ifstream in(file);
+        if (!in.is_open())
+            throw runtime_error("Cannot open " + file);
+        vector<LedgerMutation> mutations = parseLedgerMutations(in, ledger);
+        size_t firstTransaction = ledger.transactions.size();
+        string error;
+        if (!applyLedgerMutations(ledger, mutations, journal, error))
+            throw invalid_argument(error);
+        int counts[4] = {};
+        for (const LedgerMutation &mutation : mutations)
+            counts[mutation.kind]++;
+        json << "{\"file\":" << jsonString(file) << ",\"operations\":" << mutations.size() << ",\"added\":" << counts[LEDGER_ADD]
+             << ",\"bought\":" << counts[LEDGER_PURCHASE] << ",\"updated\":" << counts[LEDGER_UPDATE] << ",\"deleted\":" << counts[LEDGER_DELETE]
+             << ",\"transactions\":" << ledger.transactions.size() - firstTransaction
+             << ",\"persisted\":\"" << (journal.file != INVALID_HANDLE_VALUE ? "journal" : "csv") << "\"}";
+    }
+    else if (name == "transactions")
+    {
+        Date bounds[2];
+        const char *options[2] = {"from", "to"};
+        for (int i = 0; i < 2; i++)
+        {
+            string date = batchStringOption(command, options[i], "", true);
+            if (!Date::parse(date, bounds[i]))
+                throw invalid_argument(string("--") + options[i] + " must be a YYYY-MM-DD date");
+        }
+        string category = batchStringOption(command, "category", "");
+        int only = category.empty() ? -1 : ledger.findCategory(category);
+        if (!category.empty() && only < 0)
+            throw invalid_argument("Unknown category " + category);
+        string merchant = batchStringOption(command, "merchant", "");
+        int limit = batchIntOption(command, "limit", 100);
+        const TransactionStore &store = ledger.transactions;
+        size_t matched = 0;
+        long long total = 0;
+        json << "{\"from\":" << jsonString(batchStringOption(command, "from", "")) << ",\"to\":" << jsonString(batchStringOption(command, "to", ""))
+             << ",\"transactions\":[";
+        for (size_t id = 0; id < store.size(); id++)
+        {
+            const Transaction &record = store[id];
+            if (record.date < bounds[0] || bounds[1] < record.date || (only >= 0 && record.category != only) ||
+                (!merchant.empty() && store.merchantName(record.merchant) != merchant))
+                continue;
+            total += record.amount;
+            if ((int)matched++ >= limit)
+                continue;
+            json << (matched > 1 ? "," : "") << "{\"id\":" << id << ",\"date\":\"" << record.date.toString() << "\",\"time\":" << jsonString(formatTimeOfDay(record.time))
+                 << ",\"category\":" << jsonString(categoryName(record.category)) << ",\"merchant\":" << jsonString(string(store.merchantName(record.merchant)))
+                 << ",\"amount\":" << record.amount << ",\"card\":" << jsonString(cardName(record.card))
+                 << ",\"kind\":\"" << (record.kind == TRANSACTION_PURCHASE ? "purchase" : "adjustment") << "\"}";
+        }
+        json << "],\"count\":" << matched << ",\"total\":" << total << "}";
+    }
+    else if (name == "compact")
+    {
+        string layout = batchStringOption(command, "layout", "keep");
+        if (layout != "keep" && layout != "plain" && layout != "fixed")
+            throw invalid_argument("--layout must be keep, plain or fixed");
+        if (journal.file == INVALID_HANDLE_VALUE)
+            throw runtime_error("compact needs the default ledger and its journal");
+        int mode = layout == "keep" ? LEDGER_LAYOUT_KEEP : layout == "fixed" ? LEDGER_LAYOUT_FIXED : LEDGER_LAYOUT_PLAIN;
+        if (!journal.compact(ledger, true, mode) || filesystem::exists(journalFilename + ".compacting"))
+            throw runtime_error("Could not compact " + journalFilename);
+        json << "{\"layout\":\"" << (journal.expenseIndex.fixedWidth ? "fixed" : "plain") << "\",\"rows\":" << journal.expenseIndex.rows.size()
+             << ",\"bytes\":" << journal.expenseIndex.size << "}";
+    }
+    else
+    {
+        throw invalid_argument("Unknown command '" + name + "'");
+    }
+    return json.str();
+}
+
+int generateSyntheticLedger(const SyntheticLedgerSpec &spec, const string &expenseFile, const string &cardFile)
+{
+    if (spec.categories <= 0 || spec.cardMix.empty())
+        throw invalid_argument("A synthetic ledger needs at least one category and one card");
+    mt19937 rng(spec.seed);
+    int startYear = max(MIN_LEDGER_YEAR, 2025 - (spec.rows + 364) / 365);
+    vector<string> names;
+    vector<bool> essential;
+    for (int c = 0; c < spec.categories; ++c)
+    {
+        names.push_back(c < (int)defaultCategories.size() ? defaultCategories[c] : "category" + to_string(c + 1));
+        auto it = defaultEssentialCategories.find(names.back());
+        essential.push_back(it == defaultEssentialCategories.end() || it->second);
+    }
+    ofstream expenses(expenseFile), cards(cardFile);
+    if (!expenses.is_open() || !cards.is_open())
+        throw runtime_error("Cannot write synthetic ledger " + expenseFile);
+    expenses << "Date";
+    cards << "Date";
+    for (const string &name : names)
+    {
+        expenses << "," << name;
+        cards << "," << name;
+    }
+    expenses << "\n";
+    cards << "\n";
+    uniform_int_distribution<int> essentialAmount(50, 300), extraAmount(0, 200), spike(5, 10);
+    uniform_real_distribution<double> chance(0, 1);
+    discrete_distribution<int> cardPick(spec.cardMix.begin(), spec.cardMix.end());
+    int rows = 0;
+    Date end = Date::fromCivil(MAX_LEDGER_YEAR + 1, 1, 1);
+    for (Date date = Date::fromCivil(startYear, 1, 1); date < end && rows < spec.rows; date = date + 1)
+    {
+        char text[10];
+        size_t length = date.format(text) - text;
+        expenses.write(text, length);
+        cards.write(text, length);
+        for (int c = 0; c < spec.categories; ++c)
+        {
+            int amount = essential[c] ? essentialAmount(rng) : (chance(rng) < 0.4 ? 0 : extraAmount(rng));
+            if (essential[c] && chance(rng) < spec.anomalyRate)
+                amount *= spike(rng);
+            expenses << "," << amount;
+            cards << "," << (amount > 0 ? cardPick(rng) + 1 : 0);
+        }
+        expenses << "\n";
+        cards << "\n";
+        rows++;
+    }
+    return rows;
+}
+
+void generateTravelNetwork(int cityCount, int routeCount, unsigned seed, const string &networkFile)
+{
+    if (cityCount < 2)
+        throw invalid_argument("A travel network needs at least two cities");
+    mt19937 rng(seed);
+    uniform_int_distribution<int> hotelCost(1500, 5000), flightCost(800, 4000), city(0, cityCount - 1);
+    ofstream file(networkFile);
+    if (!file.is_open())
+        throw runtime_error("Cannot write travel network " + networkFile);
+    file << cityCount << "\n";
+    for (int i = 0; i < cityCount; ++i)
+        file << "City" << i + 1 << "\n"
+             << hotelCost(rng) << "\n";
+    routeCount = max(routeCount, cityCount - 1);
+    file << routeCount << "\n";
+    for (int i = 0; i < routeCount; ++i)
+    {
+        int from = i < cityCount - 1 ? i : city(rng);
+        int to = i < cityCount - 1 ? i + 1 : city(rng);
+        file << "City" << from + 1 << "\nCity" << to + 1 << "\n"
+             << flightCost(rng) << "\n";
+    }
+}
+
+vector<Product> generateProductCatalog(int productCount, unsigned seed)
+{
+    mt19937 rng(seed);
+    uniform_int_distribution<int> size(1, 50), margin(50, 150);
+    vector<Product> products(productCount);
+    for (Product &p : products)
+    {
+        p.size = size(rng);
+        p.profit = p.size * margin(rng);
+    }
+    return products;
+}
+
+SyntheticLedgerSpec syntheticLedgerSpec(const BatchCommand &command)
+{
+    SyntheticLedgerSpec spec;
+    spec.rows = batchIntOption(command, "rows", spec.rows);
+    spec.categories = batchIntOption(command, "categories", spec.categories);
+    spec.anomalyRate = batchDoubleOption(command, "anomaly-rate", spec.anomalyRate);
+    spec.seed = batchIntOption(command, "seed", spec.seed);
+    string mix = batchStringOption(command, "card-mix", "");
+    if (!mix.empty())
+    {
+        spec.cardMix.clear();
+        stringstream weights(mix);
+        string weight;
+        while (getline(weights, weight, ','))
+            spec.cardMix.push_back(stod(weight));
+    }
+    if (spec.rows <= 0 || spec.categories <= 0 || spec.anomalyRate < 0 || spec.anomalyRate > 1)
+        throw out_of_range("--rows and --categories must be positive and --anomaly-rate within [0, 1]");
+    return spec;
+}
+
+template <class Body>
+BenchmarkResult runBenchmark(const string &name, int iterations, long long items, Body body)
+{
+    BenchmarkResult result;
+    result.name = name;
+    result.iterations = iterations;
+    result.items = items;
+    result.minMs = numeric_limits<double>::max();
+    double totalMs = 0;
+    for (int i = 0; i < iterations; ++i)
+    {
+        auto start = chrono::steady_clock::now();
+        body();
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        result.minMs = min(result.minMs, ms);
+        result.maxMs = max(result.maxMs, ms);
+        totalMs += ms;
+    }
+    result.meanMs = totalMs / iterations;
+    cerr << "Benchmark " << name << ": " << fixed << setprecision(3) << result.meanMs << " ms mean over " << iterations << " run(s)\n";
+    return result;
+}
+
+int runGenerator(const BatchCommand &command, ostream &results)
+{
+    auto start = chrono::steady_clock::now();
+    try
+    {
+        SyntheticLedgerSpec spec = syntheticLedgerSpec(command);
+        string directory = batchStringOption(command, "dir", ".");
+        filesystem::create_directories(directory);
+        string expenseFile = (filesystem::path(directory) / filename).string();
+        string cardFile = (filesystem::path(directory) / cardFilename).string();
+        int rows = generateSyntheticLedger(spec, expenseFile, cardFile);
+        int cities = batchIntOption(command, "cities", 0);
+        if (cities > 0)
+            generateTravelNetwork(cities, batchIntOption(command, "routes", cities * 4), spec.seed, (filesystem::path(directory) / travelNetworkFilename).string());
+        results << fixed << setprecision(3) << "{\"command\":\"generate\",\"ok\":true,\"ms\":"
+                << chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() << ",\"result\":{\"expenses\":" << jsonString(expenseFile)
+                << ",\"cards\":" << jsonString(cardFile) << ",\"rows\":" << rows << ",\"categories\":" << spec.categories << ",\"cities\":" << cities << "}}" << endl;
+        return 0;
+    }
+    catch (const exception &e)
+    {
+        results << "{\"command\":\"generate\",\"ok\":false,\"error\":" << jsonString(e.what()) << "}" << endl;
+        return 2;
+    }
+}
+
+int runBenchmarks(const BatchCommand &command, int threadCount, ostream &results)
+{
+    try
+    {
+        SyntheticLedgerSpec spec = syntheticLedgerSpec(command);
+        int iterations = max(1, batchIntOption(command, "iterations", 3));
+        int cityCount = batchIntOption(command, "cities", 200);
+        int routeCount = batchIntOption(command, "routes", cityCount * 4);
+        int productCount = batchIntOption(command, "products", 200);
+        int capacity = batchIntOption(command, "capacity", 2000);
+        int savingsItems = batchIntOption(command, "savings-items", 100);
+        int goal = batchIntOption(command, "goal", 1000);
+        int reachGoal = batchIntOption(command, "reach-goal", 1000000);
+        int huffmanBytes = batchIntOption(command, "huffman-bytes", 1 << 20);
+        string directory = batchStringOption(command, "dir", "bench_data");
+        string outFile = batchStringOption(command, "out", "bench.json");
+        filesystem::create_directories(directory);
+        string expenseFile = (filesystem::path(directory) / filename).string();
+        string cardFile = (filesystem::path(directory) / cardFilename).string();
+        string networkFile = (filesystem::path(directory) / travelNetworkFilename).string();
+        int rows = generateSyntheticLedger(spec, expenseFile, cardFile);
+        generateTravelNetwork(cityCount, routeCount, spec.seed, networkFile);
+        vector<Product> products = generateProductCatalog(productCount, spec.seed);
+        vector<BenchmarkResult> benchmarks;
+        benchmarks.push_back(runBenchmark("parseCSV", iterations, rows * 2LL, [&]()
+                                          {
+            ledger = Ledger();
+            if (!parseCSV(expenseFile, cardFile, ledger, threadCount))
+                throw runtime_error("Could not import the synthetic ledger"); }));
+        benchmarks.push_back(runBenchmark("detectFraudulentTransactions", iterations, (long long)ledger.categoryCount * ledger.dayCount(), [&]()
+                                          { findFraudulentTransactions(ledger); }));
+        vector<FraudAlert> expectedAlerts;
+        for (const AnomalyKernel &kernel : availableAnomalyKernels())
+        {
+            AnomalyKernel active = anomalyKernel();
+            anomalyKernel() = kernel;
+            Ledger sweep = ledger;
+            vector<FraudAlert> alerts;
+            benchmarks.push_back(runBenchmark(string("fraudSweep.") + kernel.name, iterations, (long long)ledger.categoryCount * ledger.dayCount(), [&]()
+                                              {
+                sweep.rebuildStats();
+                alerts = findFraudulentTransactions(sweep); }));
+            anomalyKernel() = active;
+            if (expectedAlerts.empty())
+                expectedAlerts = alerts;
+            else if (alerts.size() != expectedAlerts.size() ||
+                     !equal(alerts.begin(), alerts.end(), expectedAlerts.begin(), [](const FraudAlert &a, const FraudAlert &b)
+                            { return a.day == b.day && a.category == b.category; }))
+                throw runtime_error(string("The ") + kernel.name + " anomaly kernel disagrees with the scalar kernel");
+        }
+        benchmarks.push_back(runBenchmark("findRollingAnomalies", iterations, (long long)ledger.categoryCount * ledger.dayCount(), [&]()
+                                          { findRollingAnomalies(ledger, ledger.rolling); }));
+        vector<SavingsItem> items = collectNonEssentialExpenses(ledger);
+        items.resize(min((size_t)savingsItems, items.size()));
+        benchmarks.push_back(runBenchmark("optimizeSavingsPlan", iterations, (long long)items.size() * (goal + 1), [&]()
+                                          { optimizeSavingsPlan(items, goal); }));
+        vector<SavingsItem> allItems = collectNonEssentialExpenses(ledger);
+        int expectedReach = -1;
+        for (const SubsetSumKernel &kernel : availableSubsetSumKernels())
+        {
+            SubsetSumKernel active = subsetSumKernel();
+            subsetSumKernel() = kernel;
+            int reach = 0;
+            benchmarks.push_back(runBenchmark(string("savingsReach.") + kernel.name, iterations, (long long)allItems.size() * (reachGoal / 64 + 1), [&]()
+                                              { reach = bestReachableSavings(allItems, reachGoal); }));
+            subsetSumKernel() = active;
+            if (expectedReach < 0)
+                expectedReach = reach;
+            else if (reach != expectedReach)
+                throw runtime_error(string("The ") + kernel.name + " subset-sum kernel disagrees with the scalar kernel");
+        }
+        benchmarks.push_back(runBenchmark("optimizeCreditCardPayments", iterations, (long long)ledger.categoryCount * ledger.dayCount(), [&]()
+                                          {
+            vector<CreditCard> cardVec = defaultCreditCards;
+            optimizeCreditCardPayments(ledger, cardVec, 10000); }));
+        vector<City> cities;
+        vector<vector<ERoute>> graph;
+        unordered_map<string, int> cityIndex;
+        loadTravelNetwork(networkFile, cities, graph, cityIndex);
+        benchmarks.push_back(runBenchmark("findMinTravelCost", iterations, routeCount, [&]()
+                                          {
+            vector<int> parent;
+            findMinTravelCost(cities, graph, 0, cityCount - 1, 2, 3, parent); }));
+        benchmarks.push_back(runBenchmark("allocateEmergencyFunds", iterations, ledger.dayCount(), [&]()
+                                          { computeEmergencyFunds(ledger); }));
+        ifstream source(expenseFile);
+        stringstream buffer;
+        buffer << source.rdbuf();
+        string data = buffer.str().substr(0, huffmanBytes);
+        unordered_map<char, string> huffmanCode;
+        string compressed;
+        benchmarks.push_back(runBenchmark("huffmanCompress", iterations, data.size(), [&]()
+                                          {
+            huffmanCode.clear();
+            buildHuffmanTree(data, huffmanCode);
+            compressed = compressData(data, huffmanCode); }));
+        string decompressed;
+        benchmarks.push_back(runBenchmark("huffmanDecompress", iterations, data.size(), [&]()
+                                          { decompressed = decompressData(compressed, huffmanCode); }));
+        if (decompressed != data)
+            throw runtime_error("Huffman round trip does not reproduce the input");
+        benchmarks.push_back(runBenchmark("optimizeInventory", iterations, (long long)products.size() * (capacity + 1), [&]()
+                                          { optimizeInventory(products, capacity); }));
+        const int rentBuyCalls = 10000;
+        RentBuyInput input = {100000, 25000, 45000, 5000000, 20};
+        benchmarks.push_back(runBenchmark("rentVsBuyDecision", iterations, rentBuyCalls, [&]()
+                                          {
+            for (int i = 0; i < rentBuyCalls; ++i)
+                rentVsBuyDecision(input, 0.08, 0.05); }));
+        ostringstream json;
+        json << fixed << setprecision(3);
+        json << "{\"label\":" << jsonString(batchStringOption(command, "label", "")) << ",\"timestamp\":" << time(nullptr) << ",\"threads\":" << threadCount
+             << ",\"anomalyKernel\":" << jsonString(anomalyKernel().name)
+             << ",\"config\":{\"rows\":" << rows << ",\"categories\":" << spec.categories << ",\"cards\":" << spec.cardMix.size()
+             << ",\"anomalyRate\":" << spec.anomalyRate << ",\"seed\":" << spec.seed << ",\"cities\":" << cityCount << ",\"routes\":" << routeCount
+             << ",\"products\":" << productCount << ",\"capacity\":" << capacity << ",\"savingsItems\":" << items.size() << ",\"goal\":" << goal
+             << ",\"reachGoal\":" << reachGoal << ",\"huffmanBytes\":" << data.size() << ",\"iterations\":" << iterations << "},\"benchmarks\":[";
+        for (size_t i = 0; i < benchmarks.size(); ++i)
+        {
+            const BenchmarkResult &b = benchmarks[i];
+            json << (i ? "," : "") << "{\"name\":" << jsonString(b.name) << ",\"iterations\":" << b.iterations << ",\"items\":" << b.items
+                 << ",\"minMs\":" << b.minMs << ",\"meanMs\":" << b.meanMs << ",\"maxMs\":" << b.maxMs
+                 << ",\"itemsPerSecond\":" << (b.meanMs > 0 ? b.items / b.meanMs * 1000 : 0) << "}";
+        }
+        json << "]}";
+        ofstream out(outFile);
+        out << json.str() << "\n";
+        if (!out)
+            throw runtime_error("Cannot write benchmark report " + outFile);
+        results << "{\"command\":\"bench\",\"ok\":true,\"out\":" << jsonString(outFile) << ",\"result\":" << json.str() << "}" << endl;
+        return 0;
+    }
+    catch (const exception &e)
+    {
+        results << "{\"command\":\"bench\",\"ok\":false,\"error\":" << jsonString(e.what()) << "}" << endl;
+        return 2;
+    }
+}
+
+bool WorkStealingQueue::pop(size_t &task)
+{
+    lock_guard<mutex> guard(lock);
+    if (tasks.empty())
+        return false;
+    task = tasks.back();
+    tasks.pop_back();
+    return true;
+}
+bool WorkStealingQueue::steal(size_t &task)
+{
+    lock_guard<mutex> guard(lock);
+    if (tasks.empty())
+        return false;
+    task = tasks.front();
+    tasks.pop_front();
+    return true;
+}
+
+vector<FraudScanTask> findScanLedgers(const string &directory)
+{
+    vector<FraudScanTask> tasks;
+    for (const filesystem::directory_entry &entry : filesystem::directory_iterator(directory))
+    {
+        filesystem::path path = entry.path();
+        if (entry.is_directory() && filesystem::is_regular_file(path / filename))
+        {
+            filesystem::path cards = path / cardFilename;
+            tasks.push_back({path.filename().string(), (path / filename).string(), filesystem::is_regular_file(cards) ? cards.string() : ""});
+        }
+        else if (entry.is_regular_file() && path.extension() == ".csv" && path.stem().extension() != ".cards")
+        {
+            filesystem::path cards = path.parent_path() / (path.stem().string() + ".cards.csv");
+            tasks.push_back({path.stem().string(), path.string(), filesystem::is_regular_file(cards) ? cards.string() : ""});
+        }
+    }
+    sort(tasks.begin(), tasks.end(), [](const FraudScanTask &a, const FraudScanTask &b)
+         { return a.name < b.name; });
+    return tasks;
+}
+
+// Each worker starts with a contiguous block of tasks and takes from the back of its own deque;
+// once that is empty it steals from the front of the others, so uneven ledgers even out.
+template <class Body>
+void runWorkStealing(size_t taskCount, int threadCount, Body body)
+{
+    int workerCount = (int)max<size_t>(1, min<size_t>(threadCount, taskCount));
+    vector<WorkStealingQueue> queues(workerCount);
+    for (size_t task = 0; task < taskCount; task++)
+        queues[task * workerCount / max<size_t>(taskCount, 1)].tasks.push_back(task);
+    auto worker = [&](int self)
+    {
+        size_t task;
+        while (true)
+        {
+            bool found = queues[self].pop(task);
+            for (int k = 1; k < workerCount && !found; k++)
+                found = queues[(self + k) % workerCount].steal(task);
+            if (!found)
+                return;
+            body(task, self);
+        }
+    };
+    vector<thread> workers;
+    for (int w = 1; w < workerCount; w++)
+        workers.emplace_back(worker, w);
+    worker(0);
+    for (thread &t : workers)
+        t.join();
+}
+
+string scanLedgerForFraud(const FraudScanTask &task, const RollingDetectorOptions &rolling, const IngestOptions &ingest, FraudScanTally &tally)
+{
+    Ledger scanned;
+    LedgerImport import;
+    tally.ledgers++;
+    if (!importLedger(task.expenseFile, task.cardFile, scanned, 1, ingest, import))
+        throw runtime_error(import.error);
+    vector<FraudAlert> flagged = findFraudulentTransactions(scanned);
+    vector<FraudAlert> cardSpikes = findRollingAnomalies(scanned, rolling);
+    tally.rows += import.rows;
+    tally.flagged += flagged.size();
+    tally.cardSpikes += cardSpikes.size();
+    stringstream rows;
+    rows << fixed << setprecision(2);
+    for (const vector<FraudAlert> *alerts : {&flagged, &cardSpikes})
+    {
+        for (const FraudAlert &alert : *alerts)
+        {
+            rows << task.name << "," << scanned.dateString(alert.day) << "," << scanned.categoryNames[alert.category] << ","
+                 << cardName(scanned.card(alert.category, alert.day)) << "," << alert.amount << "," << alert.threshold << ","
+                 << (alert.window > 0 ? "card-window" : "category") << "\n";
+        }
+    }
+    return rows.str();
+}
+
+int runFraudScan(const BatchCommand &command, int threadCount, const IngestOptions &ingest, ostream &results)
+{
+    auto start = chrono::steady_clock::now();
+    try
+    {
+        string directory = batchStringOption(command, "dir", "", true);
+        string outFile = batchStringOption(command, "out", "fraud_report.csv");
+        RollingDetectorOptions rolling;
+        rolling.window = batchIntOption(command, "window", rolling.window);
+        rolling.multiplier = batchDoubleOption(command, "multiplier", rolling.multiplier);
+        rolling.minSamples = batchIntOption(command, "min-samples", rolling.minSamples);
+        vector<FraudScanTask> tasks = findScanLedgers(directory);
+        ofstream report(outFile);
+        if (!report.is_open())
+            throw runtime_error("Cannot write report " + outFile);
+        report << "ledger,date,category,card,amount,threshold,detector\n";
+        mutex reportLock;
+        vector<FraudScanTally> tallies(max(1, threadCount));
+        runWorkStealing(tasks.size(), threadCount, [&](size_t index, int worker)
+                        {
+            string rows, error;
+            try
             {
-                int funds;
-                while (true)
-                {
-                    cout << "Enter your available funds for credit card payments (in Rs): ";
-                    if (isValidIntInput(funds))
-                        break;
-                    cout << "Invalid input. Please enter a non-negative numeric value.\n";
-                }
-                vector<PaymentResult> payVec = optimizeCreditCardPayments(expenseData, cardid, cardVec, funds);
-                displayResults(payVec);
-                double maxInterest = 0;
-                string maxCard;
-                for (const auto &r : payVec)
-                {
-                    if (r.interest > maxInterest)
-                    {
-                        maxInterest = r.interest;
-                        maxCard = r.card;
-                    }
-                }
-                if (maxInterest > 0)
-                {
-                    cout << "\nStrategy Suggestion: Prioritize clearing dues on card '" << maxCard
-                         << "' to reduce the highest incurred interest of Rs. " << fixed << setprecision(2) << maxInterest << ".\n";
-                }
-                else
-                {
-                    cout << "\nGreat job! All dues are covered  no interest will be incurred.\n";
-                }
-                cout << endl
-                     << endl;
-                cout << "Summary:\n";
-                cout << "The function optimizes credit card payments using a greedy approach by prioritizing low dues and high-interest cards,\n"
-                     << "allocating funds to minimize interest accumulation.\n"
-                     << "This is similar to LeetCode Problem 134 ('Gas Station') and strategies for debt repayment.\n"
-                     << "The time complexity is O(M * N + 3 log 3 + 3 log 3), where M is the number of months, and N is the number of days.\n\n";
-                break;
+                rows = scanLedgerForFraud(tasks[index], rolling, ingest, tallies[worker]);
             }
-            case 11:
-                travelExpenseMinimizer();
-                cout << "Summary:\n";
-                cout << "The function calculates the minimum travel cost using Dijkstra's algorithm, factoring in flight and hotel costs for a group. \n"
-                     << "It uses a greedy approach, prioritizing flights and hotel stays while ensuring optimal travel cost calculation.\n"
-                     << "This is similar to problems like LeetCode Problem 787, but extended to include hotel costs.\n"
-                     << "The time complexity is O(E x log V), where V is the number of cities and E is the number of flight routes.\n\n";
-                break;
-            case 12:
-                cout << "Enter your income: ";
-                int income1;
-                cin >> income1;
-                if (cin.fail())
-                {
-                    cin.clear();
-                    cin.ignore(numeric_limits<streamsize>::max(), '\n');
-                    cout << "Invalid input. Please enter a numeric value.\n";
-                    break;
-                }
-                if (income1 <= 0)
-                {
-                    cout << "Income must be a positive value.\n";
-                    break;
-                }
-                cout << "Enter the month number (1 for January, 12 for December): ";
-                int month;
-                cin >> month;
-                if (month < 1 || month > 12)
-                {
-                    cout << "Invalid month entered. Please enter a value between 1 and 12." << endl;
-                    break;
-                }
-                payVecLoan = optimizeLoanRepayment(expenseData, income1, (month - 1), loans);
-                displayLoanResults(payVecLoan);
-                cout << "Summary:\n";
-                cout << "The function optimizes loan repayments using a greedy strategy by distributing leftover income after expenses to loans with the highest interest-to-amount ratio. "
-                     << "It ensures minimal interest accumulation by prioritizing high-density loans first. "
-                     << "This is similar to greedy problems like those on LeetCode (e.g., Candy or Queue Reconstruction). "
-                     << "The time complexity is O(m log m + 31n), where m is the number of loans.\n\n";
-                break;
-            case 13:
-                int riskBudget;
-                cout << "Enter your total risk budget: ";
-                cin >> riskBudget;
-                optimizeInvestmentPortfolio(riskBudget);
-                cout << "Summary:\n";
-                cout << "The function optimizes investment selections by using a greedy strategy to choose investments with the highest return-to-risk ratio within a given total risk budget. "
-                     << "It allocates the budget across available options to maximize total return, selecting as many units as allowed by the risk constraint. "
-                     << "This is conceptually similar to the Fractional Knapsack problem on LeetCode, where items with the highest value-to-weight ratio are prioritized. "
-                     << "The topics used include Greedy Algorithms and Sorting, and the time complexity is O(n log n), where n is the number of investments.\n\n";
-                break;
-            case 14:
+            catch (const exception &e)
             {
-                int key;
-                cout << "Enter encryption key (positive integer): ";
-                cin >> key;
-                encrypt(filename, "encrypted_Expenses.csv", key);
-                encrypt(filename2, "encrypted_carddetails.csv", key);
-                cout << "Summary:\n";
-                cout << "The function 'encrypt' reads a plaintext file and writes an encrypted version to another file using a Caesar cipher by shifting alphabetic and numeric characters forward by a key. "
-                     << "It maintains case sensitivity and handles wrap-around with modular arithmetic for both letters and digits. "
-                     << "This resembles LeetCode string manipulation problems like 1844 (Replace All Digits with Characters) or 709 (To Lower Case). "
-                     << "The time complexity is O(n), where n is the number of characters in the input file.\n\n";
-                Sleep(200);
-                break;
+                error = e.what();
+                tallies[worker].failed++;
             }
-            case 15:
+            lock_guard<mutex> guard(reportLock);
+            if (error.empty())
+                report << rows;
+            else
+                cerr << "Warning: Skipped ledger " << tasks[index].name << ": " << error << endl; });
+        FraudScanTally total;
+        for (const FraudScanTally &tally : tallies)
+        {
+            total.ledgers += tally.ledgers;
+            total.failed += tally.failed;
+            total.rows += tally.rows;
+            total.flagged += tally.flagged;
+            total.cardSpikes += tally.cardSpikes;
+        }
+        report.close();
+        if (!report)
+            throw runtime_error("Could not write report " + outFile);
+        results << fixed << setprecision(3) << "{\"command\":\"scan\",\"ok\":" << (total.failed == 0 ? "true" : "false") << ",\"ms\":"
+                << chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() << ",\"result\":{\"ledgers\":" << total.ledgers
+                << ",\"failed\":" << total.failed << ",\"rows\":" << total.rows << ",\"flagged\":" << total.flagged << ",\"cardSpikes\":" << total.cardSpikes
+                << ",\"threads\":" << min<size_t>(max(1, threadCount), max<size_t>(1, tasks.size())) << ",\"report\":" << jsonString(outFile) << "}}" << endl;
+        return total.failed == 0 ? 0 : 2;
+    }
+    catch (const exception &e)
+    {
+        results << "{\"command\":\"scan\",\"ok\":false,\"error\":" << jsonString(e.what()) << "}" << endl;
+        return 2;
+    }
+}
+
+int runHeadless(int argc, char *argv[])
+{
+    headlessMode = true;
+    string expenseFile = filename, cardFile = cardFilename, scriptFile, alertsFile;
+    int threadCount = max(1u, thread::hardware_concurrency());
+    IngestOptions ingest;
+    int arg = 1;
+    for (; arg < argc && strncmp(argv[arg], "--", 2) == 0; arg += 2)
+    {
+        string option = argv[arg];
+        if (arg + 1 >= argc || (option != "--expenses" && option != "--cards" && option != "--script" && option != "--threads" &&
+                                option != "--max-errors" && option != "--diagnostics" && option != "--simd" && option != "--alerts"))
+        {
+            cerr << "Usage: aps [--expenses FILE] [--cards FILE] [--threads N] [--max-errors N] [--diagnostics FILE] [--simd scalar|sse2|avx2] [--alerts FILE]\n"
+                 << "           (--script FILE | COMMAND [--OPTION VALUE]...)\n"
+                 << "Commands: savings, fraud, range, stats, cards, travel, loans, emergency, rentbuy, inventory, recurring, edit, compact, transactions\n"
+                 << "       aps generate [--rows N] [--categories N] [--card-mix W,W,...] [--anomaly-rate R] [--seed N] [--cities N] [--dir DIR]\n"
+                 << "       aps bench [generate options] [--iterations N] [--out FILE] [--label TEXT]\n"
+                 << "       aps scan --dir DIR [--out FILE] [--window N] [--multiplier X] [--min-samples N]\n";
+            return 1;
+        }
+        if (option == "--expenses")
+            expenseFile = argv[arg + 1];
+        else if (option == "--cards")
+            cardFile = argv[arg + 1];
+        else if (option == "--script")
+            scriptFile = argv[arg + 1];
+        else if (option == "--max-errors")
+            ingest.errorBudget = strtoull(argv[arg + 1], nullptr, 10);
+        else if (option == "--diagnostics")
+            ingest.reportFile = argv[arg + 1];
+        else if (option == "--alerts")
+            alertsFile = argv[arg + 1];
+        else if (option == "--simd")
+        {
+            if (!selectAnomalyKernel(argv[arg + 1]))
             {
-                int key;
-                cout << "Enter decryption key (must match encryption key): ";
-                cin >> key;
-                decrypt("encrypted_Expenses.csv", "decrypted_Expenses.csv", key);
-                decrypt("encrypted_carddetails.csv", "decrypted_carddetails.csv", key);
-                cout << "Summary:\n";
-                cout << "The function 'decrypt' reads an encrypted file and writes the decrypted content to another file using a Caesar cipher reversal on letters and digits. "
-                     << "It preserves case and handles wrap-around with modular arithmetic for both alphabets and numbers. "
-                     << "This is similar to LeetCode problems involving string transformations, such as 2325 (Decode the Message) or 1528 (Shuffle String). "
-                     << "The time complexity is O(n), where n is the number of characters in the input file.\n\n";
-                Sleep(200);
-                break;
+                cerr << "Error: The " << argv[arg + 1] << " anomaly kernel is not available on this CPU." << endl;
+                return 1;
             }
-            case 16:
-                runRentVsBuySimulator(monthlyTotals);
-                cout << "Summary:\n";
-                cout << "The function evaluates whether renting or buying a property is financially smarter by comparing cumulative rent costs (with yearly hikes) against compounded EMI payments and maintenance using basic financial modeling. "
-                     << "It uses decision-making strategies using simulation and Financial Math modeling. "
-                     << "The time complexity is O(y) for y years of simulation, with additional O(1) compound interest math operations.\n\n";
-
-                Sleep(3000);
-                break;
-            case 17:
-                runInventoryOptimizer();
-                cout << "Summary:\n";
-                cout << "The function optimizes inventory storage using a dynamic programming strategy, selecting products that maximize profit without exceeding warehouse capacity. "
-                     << "It reconstructs the selection path to determine which products were included in the optimal solution. "
-                     << "This mirrors classic 0/1 Knapsack problems on LeetCode (e.g., '01 Knapsack' or 'Partition Equal Subset Sum'). "
-                     << "The time complexity is O(n * capacity), where n is the number of products.\n\n";
-                Sleep(3000);
-                break;
-            case 18:
-                runRecurringExpenseScheduler(monthlyTotals);
-                cout << "Summary:\n";
-                cout << "The function schedules recurring expenses by first calculating disposable income after monthly expenses, then uses a greedy strategy to prioritize bill payments based on penalty severity. "
-                     << "It ensures that the most financially damaging bills are paid first when income is limited, reducing total penalties. "
-                     << "This problem resembles greedy selection problems like LeetCode's 'Task Scheduler' or 'IPO', where maximum gain or minimum loss is prioritized under constraints. "
-                     << "The key topics include Greedy Algorithms, Sorting, and Budgeting Simulation. Time complexity is O(n log n), where n is the number of bills.\n\n";
-                Sleep(3000);
-                break;
-            case 19:
-                cout << "Exiting program...\n";
-                return;
+        }
+        else
+            threadCount = max(1, atoi(argv[arg + 1]));
+    }
+    ostream results(cout.rdbuf());
+    if (arg < argc && (strcmp(argv[arg], "generate") == 0 || strcmp(argv[arg], "bench") == 0 || strcmp(argv[arg], "scan") == 0))
+    {
+        BatchCommand command;
+        try
+        {
+            command = parseBatchCommand(vector<string>(argv + arg, argv + argc), 0);
+        }
+        catch (const exception &e)
+        {
+            results << "{\"command\":\"script\",\"ok\":false,\"error\":" << jsonString(e.what()) << "}" << endl;
+            return 1;
+        }
+        streambuf *console = cout.rdbuf(cerr.rdbuf());
+        int status = command.name == "generate" ? runGenerator(command, results)
+                     : command.name == "scan"   ? runFraudScan(command, threadCount, ingest, results)
+                                                : runBenchmarks(command, threadCount, results);
+        cout.rdbuf(console);
+        return status;
+    }
+    vector<BatchCommand> commands;
+    try
+    {
+        if (!scriptFile.empty())
+        {
+            ifstream file(scriptFile);
+            istream &script = scriptFile == "-" ? cin : file;
+            if (scriptFile != "-" && !file.is_open())
+                throw runtime_error("Cannot open script " + scriptFile);
+            string line;
+            for (int lineNumber = 1; getline(script, line); ++lineNumber)
+            {
+                vector<string> tokens = splitCommandLine(line);
+                if (!tokens.empty() && tokens[0][0] != '#')
+                    commands.push_back(parseBatchCommand(tokens, lineNumber));
             }
         }
+        if (arg < argc)
+            commands.push_back(parseBatchCommand(vector<string>(argv + arg, argv + argc), 0));
+        if (commands.empty())
+            throw invalid_argument("No commands given");
+    }
+    catch (const exception &e)
+    {
+        results << "{\"command\":\"script\",\"ok\":false,\"error\":" << jsonString(e.what()) << "}" << endl;
+        return 1;
+    }
+    streambuf *console = cout.rdbuf(cerr.rdbuf());
+    auto batchStart = chrono::steady_clock::now();
+    if (!isValidFile(expenseFile) || !isValidFile(cardFile))
+    {
+        results << "{\"command\":\"load\",\"ok\":false,\"error\":" << jsonString("Cannot open " + expenseFile + " or " + cardFile) << "}" << endl;
+        cout.rdbuf(console);
+        return 1;
+    }
+    bool defaultLedger = expenseFile == filename && cardFile == cardFilename;
+    bool checkedImport = !ingest.reportFile.empty() || ingest.errorBudget != IngestOptions().errorBudget;
+    bool fromSnapshot = defaultLedger && !checkedImport && (isSnapshotFresh(snapshotFilename, {expenseFile, cardFile}) || filesystem::exists(journalFilename + ".compacting")) &&
+                        loadLedgerSnapshot(snapshotFilename, ledger);
+    if (!fromSnapshot)
+    {
+        if (!parseCSV(expenseFile, cardFile, ledger, threadCount, ingest))
+        {
+            results << "{\"command\":\"load\",\"ok\":false,\"error\":" << jsonString("Could not import " + expenseFile + " and " + cardFile) << "}" << endl;
+            cout.rdbuf(console);
+            return 1;
+        }
+        if (defaultLedger)
+            carryTransactionDetail(snapshotFilename, ledger);
+        if (defaultLedger && !saveLedgerSnapshot(snapshotFilename, ledger, {expenseFile, cardFile}))
+            cerr << "Warning: Could not write ledger snapshot " << snapshotFilename << endl;
+    }
+    bool edits = any_of(commands.begin(), commands.end(), [](const BatchCommand &command)
+                        { return command.name == "edit" || command.name == "compact"; });
+    size_t journalRecords = 0;
+    if (defaultLedger && edits)
+        journalRecords = journal.recover(ledger, journalFilename, expenseFile, cardFile);
+    else if (defaultLedger)
+        journalRecords = replayLedgerJournal(journalFilename, ledger).records;
+    else
+    {
+        journal.expenseFile = expenseFile;
+        journal.cardFile = cardFile;
+    }
+    // The alert log starts listening after replay, so it only carries alerts for edits made by
+    // this run; journaled edits were already logged by the run that made them.
+    ofstream alertLog;
+    FraudAlertConsumer alertSink;
+    if (!alertsFile.empty())
+    {
+        alertLog.open(alertsFile);
+        if (alertLog.is_open())
+        {
+            alertSink.start(fraudAlerts, [&](const FraudAlert &alert)
+                            { alertLog << fraudAlertJson(ledger, alert) << "\n"; });
+            ledger.alertStream = &fraudAlerts;
+        }
+        else
+            cerr << "Warning: Cannot write alert log " << alertsFile << endl;
+    }
+    int activeDays = 0;
+    for (int d = 0; d < ledger.dayCount(); ++d)
+        activeDays += ledger.hasExpense(d);
+    results << fixed << setprecision(3);
+    results << "{\"command\":\"load\",\"ok\":true,\"ms\":" << chrono::duration<double, milli>(chrono::steady_clock::now() - batchStart).count()
+            << ",\"source\":\"" << (fromSnapshot ? "snapshot" : "csv") << "\",\"expenses\":" << jsonString(expenseFile)
+            << ",\"cards\":" << jsonString(cardFile) << ",\"categories\":" << ledger.categoryCount << ",\"days\":" << activeDays << ",\"journalRecords\":" << journalRecords << "}" << endl;
+    int failed = 0;
+    for (const BatchCommand &command : commands)
+    {
+        auto start = chrono::steady_clock::now();
+        string result, error;
+        try
+        {
+            result = runBatchCommand(command);
+        }
         catch (const exception &e)
         {
-            cin.clear();
-            cin.ignore(numeric_limits<streamsize>::max(), '\n');
-            cout << "Error: " << e.what() << "\nPlease try again.\n";
+            error = e.what();
+            failed++;
         }
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        results << "{\"command\":" << jsonString(command.name) << ",\"line\":" << command.line << ",\"ok\":" << (error.empty() ? "true" : "false")
+                << ",\"ms\":" << ms;
+        if (error.empty())
+            results << ",\"result\":" << result << "}" << endl;
+        else
+            results << ",\"error\":" << jsonString(error) << "}" << endl;
     }
+    ledger.alertStream = nullptr;
+    alertSink.stop();
+    journal.close();
+    if (!alertsFile.empty() && alertSink.ring.dropped > 0)
+        cerr << "Warning: The alert log " << alertsFile << " fell behind and dropped " << alertSink.ring.dropped << " alert(s)." << endl;
+    results << "{\"command\":\"summary\",\"ok\":" << (failed == 0 ? "true" : "false") << ",\"commands\":" << commands.size()
+            << ",\"failed\":" << failed << ",\"ms\":" << chrono::duration<double, milli>(chrono::steady_clock::now() - batchStart).count() << "}" << endl;
+    cout.rdbuf(console);
+    return failed == 0 ? 0 : 2;
 }
 
-void displayHeader()
-{
-    cout << "****************************************************************" << endl;
-    cout << "*                      WELCOME TO OUR                          *" << endl;
-    cout << "*         Wealthwise: Algorithmic Financial Supervisor         *" << endl;
-    cout << "*                                                              *" << endl;
-    cout << "* Submitted to:                                 Programmed by: *" << endl;
-    cout << "* Dr. Suma Dawn                                          Rishu *" << endl;
-    cout << "* Mr. Tarun Agrawal                               Swayam Gupta *" << endl;
-    cout << "* Mr. Rohit Kumar Sony                            Maanya Gupta *" << endl;
-    cout << "*                                              Priyanshu Rawat *" << endl;
-    cout << "*                                                              *" << endl;
-    cout << "****************************************************************" << "\n"
-         << endl;
-}
-
-int main()
+int main(int argc, char *argv[])
 {
+    if (argc > 1)
+        return runHeadless(argc, argv);
     string filename1 = "OctExpenses.csv";
     string filename2 = "carddetails.csv";
-    vector<int> monthlyTotals(12, 0.0);
     if (!isValidFile(filename1))
     {
         cerr << "Error: File1 not found or inaccessible." << endl;
@@ -2196,8 +5787,35 @@ int main()
         return 1;
     }
     displayHeader();
-    parseCSV(filename1, expenseData, monthlyTotals);
-    parseCSV(filename2, cardid, monthlyTotals);
-    menu(monthlyTotals);
+    auto start = chrono::steady_clock::now();
+    // While a fold is pending the CSV files may be half patched; the snapshot predates the fold
+    // and replaying both journals on top of it gives the exact ledger.
+    bool folding = filesystem::exists(journalFilename + ".compacting");
+    if ((isSnapshotFresh(snapshotFilename, {filename1, filename2}) || folding) && loadLedgerSnapshot(snapshotFilename, ledger))
+    {
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        cout << "Loaded ledger snapshot " << snapshotFilename << " in " << fixed << setprecision(2) << ms << " ms\n";
+        cout.unsetf(ios::fixed);
+        cout << setprecision(6);
+    }
+    else
+    {
+        int threadCount = max(1u, thread::hardware_concurrency());
+        if (!parseCSV(filename1, filename2, ledger, threadCount))
+            return 1;
+        carryTransactionDetail(snapshotFilename, ledger);
+        if (!saveLedgerSnapshot(snapshotFilename, ledger, {filename1, filename2}))
+            cerr << "Warning: Could not write ledger snapshot " << snapshotFilename << endl;
+    }
+    size_t replayed = journal.recover(ledger, journalFilename, filename1, filename2);
+    if (replayed > 0)
+        cout << "Replayed " << replayed << " journaled edit(s) from " << journalFilename << "\n";
+    detectFraudulentTransactions();
+    fraudAlerts.callbacks.push_back(printFraudAlert);
+    ledger.alertStream = &fraudAlerts;
+    menu();
+    if (journal.records > 0)
+        journal.compact(ledger, true);
+    journal.close();
     return 0;
 }
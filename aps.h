@@ -10,18 +10,185 @@
 #include <unordered_map>
 #include <set>
 #include <queue>
+#include <deque>
 #include <cmath>
 #include <algorithm>
 #include <iomanip>
-#include <regex>
 #include <thread>
 #include <chrono>
 #include <stdexcept>
 #include <limits>
+#include <charconv>
+#include <cstdint>
+#include <filesystem>
+#include <random>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <bitset>
+#include <memory>
+#include <string_view>
 #include <windows.h>
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define APS_X86_SIMD 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define APS_TARGET_AVX2
+#else
+#define APS_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
 using namespace std;
-#define MAX_NODES 372
-#define MAX_EDGES 400
+#define MIN_LEDGER_YEAR 1900
+#define MAX_LEDGER_YEAR 2100
+#define SNAPSHOT_VERSION 7
+#define FIXED_CATEGORY_COUNT 6
+#define INGEST_BAD_DATE_FORMAT 0
+#define INGEST_BAD_DATE 1
+#define INGEST_BAD_AMOUNT 2
+#define INGEST_ERROR_KINDS 3
+#define INGEST_SUMMARY_EXAMPLES 10
+#define WINDOW_QUANTILE_CUTS 3
+#define JOURNAL_CATEGORIES 0
+#define JOURNAL_SET_CELL 1
+#define JOURNAL_SET_DAY 2
+#define JOURNAL_CLEAR_DAY 3
+#define JOURNAL_BATCH 4
+#define LEDGER_ADD 0
+#define LEDGER_UPDATE 1
+#define LEDGER_DELETE 2
+#define LEDGER_PURCHASE 3
+#define JOURNAL_TRANSACTIONS 5
+#define TRANSACTION_PURCHASE 0
+#define TRANSACTION_ADJUSTMENT 1
+#define TRANSACTION_BLOCK_SIZE (1 << 16)
+#define MERCHANT_BLOCK_SIZE (1 << 16)
+#define LEDGER_FIELD_WIDTH 10
+#define LEDGER_LAYOUT_KEEP -1
+#define LEDGER_LAYOUT_PLAIN 0
+#define LEDGER_LAYOUT_FIXED 1
+#define LEDGER_INDEX_VERSION 1
+#define JOURNAL_COMPACT_BYTES (1 << 20)
+#define SAVINGS_MATRIX_BITS ((size_t)1 << 28)
+#define SAVINGS_UNREACHED (1 << 30)
+#define SAVINGS_WAYS_PRIME ((1ULL << 61) - 1)
+constexpr int8_t monthLengths[2][12] = {{31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31},
+                                        {31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31}};
+constexpr int16_t monthStarts[2][13] = {{0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334, 365},
+                                        {0, 31, 60, 91, 121, 152, 182, 213, 244, 274, 305, 335, 366}};
+// A calendar day stored as days since 1970-01-01.
+class Date
+{
+public:
+    int32_t days = 0;
+    constexpr Date() = default;
+    constexpr explicit Date(int32_t value) : days(value) {}
+    static constexpr bool isLeapYear(int year) { return year % 4 == 0 && (year % 100 != 0 || year % 400 == 0); }
+    static constexpr int daysInMonth(int year, int month) { return monthLengths[isLeapYear(year)][month - 1]; }
+    static constexpr bool isValid(int year, int month, int day)
+    {
+        return year >= 1 && year <= 9999 && month >= 1 && month <= 12 && day >= 1 && day <= daysInMonth(year, month);
+    }
+    static constexpr int32_t daysBeforeYear(int year)
+    {
+        int y = year - 1;
+        return y * 365 + y / 4 - y / 100 + y / 400 - 719162;
+    }
+    static constexpr int daysBetweenYears(int first, int end) { return daysBeforeYear(end) - daysBeforeYear(first); }
+    static constexpr Date fromCivil(int year, int month, int day)
+    {
+        return Date(daysBeforeYear(year) + monthStarts[isLeapYear(year)][month - 1] + day - 1);
+    }
+    static constexpr bool fromNumber(int value, Date &date)
+    {
+        int year = value / 10000, month = value / 100 % 100, day = value % 100;
+        if (!isValid(year, month, day))
+            return false;
+        date = fromCivil(year, month, day);
+        return true;
+    }
+    static constexpr bool isWellFormed(const char *text, size_t length)
+    {
+        if (length != 10 || text[4] != '-' || text[7] != '-')
+            return false;
+        for (size_t i = 0; i < length; i++)
+            if (i != 4 && i != 7 && (text[i] < '0' || text[i] > '9'))
+                return false;
+        return true;
+    }
+    // Parses exactly YYYY-MM-DD and rejects dates the calendar does not have.
+    static constexpr bool parse(const char *text, size_t length, Date &date)
+    {
+        if (!isWellFormed(text, length))
+            return false;
+        int year = (text[0] - '0') * 1000 + (text[1] - '0') * 100 + (text[2] - '0') * 10 + (text[3] - '0');
+        int month = (text[5] - '0') * 10 + (text[6] - '0');
+        int day = (text[8] - '0') * 10 + (text[9] - '0');
+        if (!isValid(year, month, day))
+            return false;
+        date = fromCivil(year, month, day);
+        return true;
+    }
+    static bool parse(string_view text, Date &date) { return parse(text.data(), text.size(), date); }
+    constexpr int year() const
+    {
+        int year = 1970 + (int)((int64_t)days * 400 / 146097);
+        while (daysBeforeYear(year) > days)
+            year--;
+        while (daysBeforeYear(year + 1) <= days)
+            year++;
+        return year;
+    }
+    constexpr void civil(int &year, int &month, int &day) const
+    {
+        year = this->year();
+        int dayOfYear = days - daysBeforeYear(year);
+        const int16_t *starts = monthStarts[isLeapYear(year)];
+        month = dayOfYear / 31 + 1;
+        if (month < 12 && dayOfYear >= starts[month])
+            month++;
+        day = dayOfYear - starts[month - 1] + 1;
+    }
+    constexpr int number() const
+    {
+        int year = 0, month = 0, day = 0;
+        civil(year, month, day);
+        return year * 10000 + month * 100 + day;
+    }
+    // Writes the ten characters of YYYY-MM-DD without a terminator and returns the end.
+    constexpr char *format(char *out) const
+    {
+        int year = 0, month = 0, day = 0;
+        civil(year, month, day);
+        out[0] = (char)('0' + year / 1000 % 10);
+        out[1] = (char)('0' + year / 100 % 10);
+        out[2] = (char)('0' + year / 10 % 10);
+        out[3] = (char)('0' + year % 10);
+        out[4] = '-';
+        out[5] = (char)('0' + month / 10);
+        out[6] = (char)('0' + month % 10);
+        out[7] = '-';
+        out[8] = (char)('0' + day / 10);
+        out[9] = (char)('0' + day % 10);
+        return out + 10;
+    }
+    string toString() const
+    {
+        char text[10];
+        return string(text, format(text));
+    }
+    constexpr Date operator+(int offset) const { return Date(days + offset); }
+    constexpr int operator-(Date other) const { return days - other.days; }
+    constexpr bool operator==(Date other) const { return days == other.days; }
+    constexpr bool operator!=(Date other) const { return days != other.days; }
+    constexpr bool operator<(Date other) const { return days < other.days; }
+    constexpr bool operator<=(Date other) const { return days <= other.days; }
+};
+static_assert(Date::fromCivil(1970, 1, 1).days == 0, "Date epoch is 1970-01-01");
+static_assert(Date::fromCivil(2000, 3, 1).days == 11017, "Date handles leap centuries");
+static_assert(Date(11016).number() == 20000229, "Date converts back to the civil calendar");
 class City
 {
 public:
@@ -153,11 +320,6 @@ public:
     int unitsSelected;
     int totalReturn;
 };
-vector<vector<pair<vector<int>, vector<int>>>> expenseData(12, vector<pair<vector<int>, vector<int>>>(31, {{0, 0, 0}, {0, 0, 0}}));
-vector<vector<pair<vector<int>, vector<int>>>> cardid(12, vector<pair<vector<int>, vector<int>>>(31, {{0, 0, 0}, {0, 0, 0}}));
-vector<string> essentialCategories = {"food", "work", "travel"};
-vector<string> nonEssentialCategories = {"snacks", "fun", "extra"};
-const string filename = "OctExpenses.csv";
 class Edge
 {
 public:
@@ -165,8 +327,548 @@ public:
     int dest;
     double weight;
 };
-int parent[MAX_NODES];
-int rankArr[MAX_NODES];
+class SavingsItem
+{
+public:
+    int amount;
+    Date date;
+    int category;
+};
+class SavingsResult
+{
+public:
+    int goal = 0;
+    int totalSavings = 0;
+    int entryCount = 0;
+    vector<SavingsItem> selected;
+};
+class FraudAlert
+{
+public:
+    int day;
+    int category;
+    int amount;
+    double threshold;
+    int card = 0;
+    int window = 0;
+    double score = 0;
+};
+class FraudAlertRing
+{
+public:
+    vector<FraudAlert> slots;
+    atomic<size_t> head{0};
+    atomic<size_t> tail{0};
+    atomic<size_t> dropped{0};
+    explicit FraudAlertRing(size_t capacity = 4096) : slots(max<size_t>(1, capacity)) {}
+    bool push(const FraudAlert &alert);
+    bool pop(FraudAlert &alert);
+};
+// fraudAlerts carries live alerts for edits as they land; a sweep over the whole ledger
+// publishes to a stream of its own so it never reaches the live subscribers. Callbacks and
+// rings are only added or removed on the thread that publishes (FraudAlertConsumer::start and
+// stop run there too); consumers hand alerts to other threads through their ring.
+class FraudAlertStream
+{
+public:
+    vector<function<void(const FraudAlert &)>> callbacks;
+    vector<FraudAlertRing *> rings;
+    void publish(const FraudAlert &alert) const;
+};
+class FraudAlertConsumer
+{
+public:
+    FraudAlertRing ring;
+    FraudAlertStream *stream = nullptr;
+    atomic<bool> stopping{false};
+    thread worker;
+    explicit FraudAlertConsumer(size_t capacity = 1 << 16) : ring(capacity) {}
+    void start(FraudAlertStream &source, function<void(const FraudAlert &)> handle);
+    void stop();
+    ~FraudAlertConsumer() { stop(); }
+};
+class EmergencyFundResult
+{
+public:
+    vector<long long> dayTotals;
+    vector<Edge> transfers;
+    double totalCost = 0;
+};
+class TravelResult
+{
+public:
+    int totalCost = -1;
+    vector<string> path;
+};
+class BatchCommand
+{
+public:
+    string name;
+    map<string, string> options;
+    int line = 0;
+};
+class SyntheticLedgerSpec
+{
+public:
+    int rows = 20000;
+    int categories = FIXED_CATEGORY_COUNT;
+    vector<double> cardMix = {1, 1, 1};
+    double anomalyRate = 0.01;
+    unsigned seed = 42;
+};
+class BenchmarkResult
+{
+public:
+    string name;
+    int iterations = 0;
+    long long items = 0;
+    double minMs = 0;
+    double meanMs = 0;
+    double maxMs = 0;
+};
+class FraudScanTask
+{
+public:
+    string name;
+    string expenseFile;
+    string cardFile;
+};
+class FraudScanTally
+{
+public:
+    int ledgers = 0;
+    int failed = 0;
+    size_t rows = 0;
+    size_t flagged = 0;
+    size_t cardSpikes = 0;
+};
+class WorkStealingQueue
+{
+public:
+    mutex lock;
+    deque<size_t> tasks;
+    bool pop(size_t &task);
+    bool steal(size_t &task);
+};
+class SnapshotHeader
+{
+public:
+    char magic[8];
+    uint32_t version;
+    int32_t firstYear;
+    int32_t yearCount;
+    int32_t categoryCount;
+    uint64_t payloadBytes;
+    uint64_t checksum;
+    uint64_t sourceSize[2];
+    int64_t sourceModified[2];
+};
+class MappedFile
+{
+public:
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+    const char *data = nullptr;
+    size_t size = 0;
+    bool open(const string &filename);
+    void close();
+    ~MappedFile() { close(); }
+};
+class JournalRecordHeader
+{
+public:
+    uint32_t size;
+    uint32_t checksum;
+    int32_t date;
+    uint8_t kind;
+    uint8_t reserved[3];
+};
+class LedgerMutation
+{
+public:
+    int kind = LEDGER_ADD;
+    string date;
+    int category = -1;
+    vector<int> amounts;
+    vector<int> cards;
+    string merchant;
+    int time = -1;
+};
+class JournalReplay
+{
+public:
+    size_t records = 0;
+    uint64_t validBytes = 0;
+    bool rejected = false;
+    bool pendingBase = false;
+    vector<int> dates;
+};
+class LedgerRowSpan
+{
+public:
+    uint64_t offset = 0;
+    uint32_t length = 0;
+};
+class LedgerFileIndex
+{
+public:
+    uint64_t size = 0;
+    int64_t modified = 0;
+    bool fixedWidth = false;
+    unordered_map<int, LedgerRowSpan> rows;
+    const LedgerRowSpan *find(int date) const
+    {
+        auto it = rows.find(date);
+        return it == rows.end() ? nullptr : &it->second;
+    }
+};
+class CategoryStats
+{
+public:
+    long long count = 0;
+    double mean = 0;
+    double m2 = 0;
+    void add(double value);
+    void remove(double value);
+    void merge(const CategoryStats &other);
+    void replace(int oldValue, int newValue)
+    {
+        if (oldValue > 0)
+            remove(oldValue);
+        if (newValue > 0)
+            add(newValue);
+    }
+    double stddev() const { return count > 1 ? sqrt(m2 / count) : 0; }
+    double threshold() const { return mean + 2 * stddev(); }
+};
+class WindowQuantiles
+{
+public:
+    multiset<int> buckets[WINDOW_QUANTILE_CUTS + 1];
+    int size = 0;
+    void insert(int value);
+    void erase(int value);
+    void rebalance();
+    double quantile(int cut) const;
+};
+class RollingDetectorOptions
+{
+public:
+    int window = 90;
+    double multiplier = 3;
+    double minSpread = 0.1;
+    int minSamples = 8;
+    double spread(const WindowQuantiles &quantiles) const;
+    double threshold(const WindowQuantiles &quantiles) const { return quantiles.quantile(2) + multiplier * spread(quantiles); }
+};
+class RollingWindow
+{
+public:
+    deque<pair<int, int>> entries;
+    WindowQuantiles quantiles;
+};
+class RollingWindowDetector
+{
+public:
+    RollingDetectorOptions options;
+    map<pair<int, int>, RollingWindow> windows;
+    bool observe(int day, int category, int card, int amount, FraudAlert &alert);
+};
+class Transaction
+{
+public:
+    Date date;
+    int32_t amount;
+    uint32_t merchant;
+    int32_t time;
+    uint16_t category;
+    uint8_t card;
+    uint8_t kind;
+};
+class TransactionStore
+{
+public:
+    vector<shared_ptr<Transaction[]>> blocks;
+    size_t count = 0;
+    vector<shared_ptr<char[]>> merchantBlocks;
+    size_t merchantUsed = MERCHANT_BLOCK_SIZE;
+    vector<string_view> merchants;
+    unordered_map<string_view, uint32_t> merchantIds;
+    size_t size() const { return count; }
+    const Transaction &operator[](size_t id) const { return blocks[id / TRANSACTION_BLOCK_SIZE][id % TRANSACTION_BLOCK_SIZE]; }
+    string_view merchantName(uint32_t id) const { return id < merchants.size() ? merchants[id] : string_view(); }
+    uint32_t internMerchant(string_view name);
+    size_t append(const Transaction &record);
+    void truncate(size_t newCount) { count = min(count, newCount); }
+};
+class FenwickTree
+{
+public:
+    vector<long long> tree;
+    void build(const int *values, int count);
+    void add(int index, long long delta);
+    long long prefix(int end) const;
+    long long range(int first, int end) const { return prefix(end) - prefix(first); }
+};
+class AnomalyKernel
+{
+public:
+    const char *name;
+    CategoryStats (*statistics)(const int *column, int count);
+    void (*scan)(const int *column, int count, int threshold, vector<int> &hits);
+};
+class SubsetSumKernel
+{
+public:
+    const char *name;
+    void (*shiftOr)(uint64_t *reach, size_t words, int shift);
+    void (*relax)(int *count, int target, int amount);
+};
+class SavingsReach;
+class RollingEditWindows;
+// State a Ledger derives from its cells and keeps current across edits. Each ledger owns its
+// own: a copy starts empty and rebuilds on first use rather than updating the original's.
+template <class T>
+class LedgerCache
+{
+public:
+    unique_ptr<T> state;
+    LedgerCache() = default;
+    LedgerCache(const LedgerCache &) {}
+    LedgerCache(LedgerCache &&) = default;
+    LedgerCache &operator=(const LedgerCache &other)
+    {
+        if (this != &other)
+            state.reset();
+        return *this;
+    }
+    LedgerCache &operator=(LedgerCache &&) = default;
+    T *get() const { return state.get(); }
+    T &obtain()
+    {
+        if (!state)
+            state.reset(new T());
+        return *state;
+    }
+};
+class Ledger
+{
+public:
+    int firstYear = 0;
+    int yearCount = 0;
+    int categoryCount = 0;
+    vector<string> categoryNames;
+    vector<char> essential;
+    vector<int> amounts;
+    vector<int> cards;
+    vector<CategoryStats> stats;
+    vector<FenwickTree> totals;
+    TransactionStore transactions;
+    RollingDetectorOptions rolling;
+    const FraudAlertStream *alertStream = nullptr;
+    uint64_t version = 0;
+    LedgerCache<SavingsReach> savingsReach;
+    LedgerCache<RollingEditWindows> rollingWindows;
+    Date origin;
+    int days = 0;
+    int dayCount() const { return days; }
+    bool hasYear(int year) const { return yearCount > 0 && year >= firstYear && year < firstYear + yearCount; }
+    void setYears(int first, int count);
+    void touch();
+    int dayOf(Date date) const { return date - origin; }
+    Date dateOf(int day) const { return origin + day; }
+    int dayIndex(int year, int month, int day) const { return dayOf(Date::fromCivil(year, month + 1, day + 1)); }
+    int amount(int category, int day) const { return amounts[(size_t)category * dayCount() + day]; }
+    int &amount(int category, int day) { return amounts[(size_t)category * dayCount() + day]; }
+    int card(int category, int day) const { return cards[(size_t)category * dayCount() + day]; }
+    int &card(int category, int day) { return cards[(size_t)category * dayCount() + day]; }
+    const int *amountColumn(int category) const { return amounts.data() + (size_t)category * dayCount(); }
+    const int *cardColumn(int category) const { return cards.data() + (size_t)category * dayCount(); }
+    void setCategories(const vector<string> &names, const map<string, bool> &essentialConfig);
+    int findCategory(const string &name) const;
+    void ensureYear(int year);
+    void merge(const Ledger &other);
+    bool hasExpense(int day) const;
+    bool isAnomalous(int category, int value) const { return essential[category] && value > stats[category].threshold(); }
+    FraudAlert thresholdAlert(int category, int day, int value) const;
+    bool isRollingAnomaly(int category, int day, int value, FraudAlert &alert);
+    void setAmount(int category, int day, int value);
+    void setCard(int category, int day, int id);
+    void addAmount(int category, int day, int delta) { setAmount(category, day, amount(category, day) + delta); }
+    void clearDay(int day);
+    size_t addTransaction(const Transaction &record);
+    void rebuildStats();
+    void rebuildTotals();
+    long long rangeTotal(int category, int firstDay, int endDay) const { return totals[category].range(firstDay, endDay); }
+    long long rangeTotal(int firstDay, int endDay) const;
+    long long monthTotal(int year, int month) const;
+    void latestMonth(int &year, int &month) const;
+    int latestYearOf(int month) const;
+    int clampDay(Date date) const { return max(0, min(dayOf(date), dayCount())); }
+    vector<long long> dayTotals() const;
+    string dateString(int day) const;
+};
+class SavingsIndex
+{
+public:
+    uint64_t version = 0;
+    int maxGoal = -1;
+    vector<SavingsItem> items;
+    vector<int> count;
+    vector<int> best;
+    vector<uint64_t> taken;
+    mutable map<int, SavingsResult> answers;
+    bool covers(const Ledger &ledger, int goal) const { return version == ledger.version && goal <= maxGoal; }
+    void build(const Ledger &ledger, int goal);
+    SavingsResult query(int goal) const;
+};
+class RollingEditWindow
+{
+public:
+    int end = 0;
+    WindowQuantiles quantiles;
+};
+class RollingEditWindows
+{
+public:
+    uint64_t version = 0;
+    int window = 0;
+    map<pair<int, int>, RollingEditWindow> windows;
+    bool current(const Ledger &ledger) const { return version == ledger.version && window == ledger.rolling.window; }
+    void reset(const Ledger &ledger);
+    void update(int card, int category, int day, int oldValue, int newValue);
+    const WindowQuantiles &slide(const Ledger &ledger, int card, int category, int day);
+};
+class SavingsReach
+{
+public:
+    uint64_t version = 0;
+    int maxGoal = -1;
+    size_t items = 0;
+    vector<uint64_t> ways;
+    vector<uint64_t> reach;
+    bool current(const Ledger &ledger) const { return version == ledger.version; }
+    bool covers(const Ledger &ledger, int goal) const { return current(ledger) && goal <= maxGoal; }
+    void build(const Ledger &ledger, int goal);
+    void insert(int amount);
+    void erase(int amount);
+    void replace(int oldAmount, int newAmount)
+    {
+        if (oldAmount > 0)
+            erase(oldAmount);
+        if (newAmount > 0)
+            insert(newAmount);
+    }
+    int best(int goal) const;
+};
+Ledger ledger;
+FraudAlertStream fraudAlerts;
+class LedgerJournal
+{
+public:
+    string path;
+    string expenseFile;
+    string cardFile;
+    HANDLE file = INVALID_HANDLE_VALUE;
+    mutex lock;
+    condition_variable wake;
+    condition_variable committed;
+    string pending;
+    uint64_t appended = 0;
+    uint64_t durable = 0;
+    uint64_t bytes = 0;
+    size_t records = 0;
+    bool failed = false;
+    bool stopping = false;
+    thread committer;
+    thread compactor;
+    vector<int> dirty;
+    vector<int> unfolded;
+    bool foldFailed = false;
+    LedgerFileIndex expenseIndex;
+    LedgerFileIndex cardIndex;
+    size_t recover(Ledger &ledger, const string &journalFile, const string &expenses, const string &cards);
+    bool open(const Ledger &ledger, uint64_t validBytes);
+    bool append(int kind, int date, const void *payload, size_t size);
+    bool commit(const Ledger &ledger, const vector<int> &days, const vector<pair<int, int>> &cells, size_t firstTransaction);
+    void commitLoop();
+    bool compact(const Ledger &ledger, bool wait, int layout = LEDGER_LAYOUT_KEEP);
+    bool fold(const Ledger &base, const vector<int> &dates, int layout);
+    void close();
+    ~LedgerJournal() { close(); }
+};
+LedgerJournal journal;
+class IngestOptions
+{
+public:
+    size_t errorBudget = numeric_limits<size_t>::max();
+    size_t capacity = 4096;
+    string reportFile;
+};
+class IngestIssue
+{
+public:
+    const char *text;
+    const char *textEnd;
+    uint32_t lineNumber;
+    uint16_t column;
+    uint8_t kind;
+    uint8_t cardFile;
+};
+class IngestDiagnostics
+{
+public:
+    vector<IngestIssue> issues;
+    size_t capacity = 0;
+    size_t counts[2][INGEST_ERROR_KINDS] = {};
+    atomic<size_t> *errorCount = nullptr;
+    size_t errorBudget = numeric_limits<size_t>::max();
+    void record(const char *text, const char *textEnd, size_t lineNumber, int column, int kind, bool cardFile);
+    bool overBudget() const { return errorCount && errorCount->load(memory_order_relaxed) > errorBudget; }
+};
+class CSVChunk
+{
+public:
+    Ledger ledger;
+    IngestDiagnostics diagnostics;
+    size_t rows = 0;
+    size_t cardRows = 0;
+    bool joined = false;
+    unordered_map<int, pair<int, int>> dateRows; // expense and card rows, keyed by days since MIN_LEDGER_YEAR-01-01
+};
+class LedgerImport
+{
+public:
+    MappedFile expenses;
+    MappedFile cards;
+    IngestDiagnostics diagnostics;
+    map<int, int> mismatches;
+    vector<string> warnings;
+    string error;
+    size_t rows = 0;
+    size_t cardRows = 0;
+    size_t chunkCount = 0;
+    double seconds = 0;
+    bool parsed = false;
+};
+const vector<string> defaultCategories = {"food", "work", "travel", "snacks", "fun", "extra"};
+const map<string, bool> defaultEssentialCategories = {{"food", true}, {"work", true}, {"travel", true}, {"snacks", false}, {"fun", false}, {"extra", false}};
+const string filename = "OctExpenses.csv";
+const string cardFilename = "carddetails.csv";
+const string snapshotFilename = "ledger.snap";
+const string journalFilename = "ledger.journal";
+const string ledgerIndexFilename = "ledger.index";
+const string categoryConfigFilename = "categories.cfg";
+const char *const ingestErrorNames[INGEST_ERROR_KINDS] = {"invalid date format", "invalid date", "invalid amount"};
+const double windowQuantileCuts[WINDOW_QUANTILE_CUTS] = {0.25, 0.5, 0.75};
+const string travelNetworkFilename = "travelinput.txt";
+const vector<Product> defaultProducts = {{4, 400}, {3, 300}, {2, 200}, {1, 100}, {5, 500}, {6, 600}, {7, 700}, {8, 800}, {9, 900}, {10, 1000}, {11, 1100}, {12, 1200}};
+const vector<RecurringBill> defaultRecurringBills = {{"Electricity", 1500, 10, 100}, {"Credit Card", 4000, 5, 200}, {"Mobile Bill", 1000, 15, 50}, {"Internet", 1200, 20, 80}};
+const vector<CreditCard> defaultCreditCards = {{}, {"A", 3.5, 500, 15}, {"B", 2.0, 300, 12}, {"C", 1.5, 200, 18}};
+const vector<Loan> defaultLoans = {Loan(1, 15000, 10.5), Loan(2, 20000, 8.2), Loan(3, 12000, 12.0), Loan(4, 5000, 5.0), Loan(5, 8000, 7.5), Loan(6, 10000, 9.0), Loan(7, 7000, 6.5)};
+bool headlessMode = false;
+vector<int> parent;
+vector<int> rankArr;
 class HuffmanNode
 {
 public:
@@ -187,9 +889,51 @@ bool isValidFile(const string &filename);
 bool isValidCSV(const string &line);
 bool isValidDoubleInput(double &input);
 bool isValidIntInput(int &input);
-bool isValidDate(int year, int month, int day);
-bool validateDateFormat(const string &date);
-void parseCSV(const string &filename, vector<vector<pair<vector<int>, vector<int>>>> &vec, vector<int> &monthlyTotals);
+const char *nextLine(const char *p, const char *end, const char *&lineEnd);
+bool parseIntField(const char *p, const char *end, int &value);
+const string &categoryName(int category);
+string cardName(int card);
+map<string, bool> loadCategoryConfig(const string &configFile);
+vector<string> parseCSVHeader(const char *line, const char *lineEnd);
+template <int FixedCategories>
+int parseLedgerRow(const char *line, const char *lineEnd, bool isCardFile, CSVChunk &chunk);
+template <int FixedCategories>
+void parseCSVChunk(const char *expense, const char *expenseEnd, const char *card, const char *cardEnd, CSVChunk &chunk);
+vector<const char *> splitCSVChunks(const char *p, const char *end, size_t chunkCount);
+const char *alignCSVChunk(const char *expenseLine, const char *expenseEnd, const char *cardBegin, const char *cardEnd, const char *guess);
+bool importLedger(const string &expenseFile, const string &cardFile, Ledger &ledger, int threadCount, const IngestOptions &options, LedgerImport &import);
+bool parseCSV(const string &expenseFile, const string &cardFile, Ledger &ledger, int threadCount = 1, const IngestOptions &options = IngestOptions());
+bool reportIngestDiagnostics(const string &expenseFile, const string &cardFile, const IngestDiagnostics &diagnostics, const IngestOptions &options);
+void reportLedgerMismatches(const string &expenseFile, const string &cardFile, const map<int, int> &mismatches);
+uint64_t snapshotChecksum(const char *data, size_t size);
+bool isSnapshotFresh(const string &snapshotFile, const vector<string> &sources);
+bool loadLedgerSnapshot(const string &snapshotFile, Ledger &ledger);
+bool saveLedgerSnapshot(const string &snapshotFile, const Ledger &ledger, const vector<string> &sources);
+void carryTransactionDetail(const string &snapshotFile, Ledger &ledger);
+int ledgerDate(const Ledger &ledger, int day);
+string journalCategories(const Ledger &ledger);
+string encodeJournalRecord(int kind, int date, const void *payload, size_t size);
+string encodeJournalDay(const Ledger &ledger, int day);
+string encodeJournalTransactions(const TransactionStore &store, size_t first);
+bool checkJournalRecord(const Ledger &ledger, const JournalRecordHeader &header, const char *payload, size_t &transactionCount);
+bool applyJournalRecord(Ledger &ledger, const JournalRecordHeader &header, const char *payload, vector<int> *dates = nullptr);
+bool replayJournalFile(const string &journalFile, Ledger &ledger, JournalReplay &replay);
+JournalReplay replayLedgerJournal(const string &journalFile, Ledger &ledger);
+bool writeFileDurably(const string &path, const string &data);
+string formatLedgerRow(const Ledger &ledger, int day, bool cards, bool fixedWidth);
+bool writeLedgerCSV(const Ledger &ledger, const string &expenseFile, const string &cardFile, bool fixedWidth = false);
+int64_t fileModifiedTime(const string &file);
+void indexLedgerRows(const char *data, size_t size, LedgerFileIndex &index);
+bool buildLedgerFileIndex(const string &file, LedgerFileIndex &index);
+bool isLedgerIndexCurrent(const string &file, const LedgerFileIndex &index);
+bool loadLedgerIndex(const string &indexFile, LedgerFileIndex &expenses, LedgerFileIndex &cards);
+bool saveLedgerIndex(const string &indexFile, const LedgerFileIndex &expenses, const LedgerFileIndex &cards);
+bool patchLedgerCSV(const Ledger &ledger, const vector<int> &dates, const string &expenseFile, const string &cardFile, LedgerFileIndex &expenseIndex, LedgerFileIndex &cardIndex);
+bool parseMutationDate(const string &text, Date &date);
+bool applyLedgerMutations(Ledger &ledger, const vector<LedgerMutation> &mutations, LedgerJournal &journal, string &error);
+vector<LedgerMutation> parseLedgerMutations(istream &in, const Ledger &ledger);
+int parseTimeOfDay(const string &text);
+string formatTimeOfDay(int seconds);
 void loadExpenseData(map<string, double> &expenses);
 void saveExpenseData(const map<string, double> &expenses);
 void updateExpenseData();
@@ -197,19 +941,64 @@ void restoreExpenseData();
 void displayExpenses();
 void addExpense();
 void updateExpense();
-bool deleteExpenses(string &filename, string &date);
+bool deleteExpenses(const string &date);
 void listAllExpenses(const map<string, double> &expenses);
-void menu(vector<int> &monthlyTotals);
+void menu();
+void pauseFor(int milliseconds);
+CategoryStats statisticsFromSums(long long count, double pivot, double sum, double sumSquares);
+CategoryStats columnStatisticsScalar(const int *column, int count);
+void scanAboveThresholdScalar(const int *column, int count, int threshold, vector<int> &hits);
+#ifdef APS_X86_SIMD
+CategoryStats columnStatisticsSSE2(const int *column, int count);
+void scanAboveThresholdSSE2(const int *column, int count, int threshold, vector<int> &hits);
+APS_TARGET_AVX2 CategoryStats columnStatisticsAVX2(const int *column, int count);
+APS_TARGET_AVX2 void scanAboveThresholdAVX2(const int *column, int count, int threshold, vector<int> &hits);
+bool cpuSupportsAVX2();
+#endif
+vector<AnomalyKernel> availableAnomalyKernels();
+AnomalyKernel &anomalyKernel();
+bool selectAnomalyKernel(const string &name);
+void publishThresholdAlerts(const Ledger &ledger, const FraudAlertStream &stream);
+void publishRollingAlerts(const Ledger &ledger, const RollingDetectorOptions &options, const FraudAlertStream &stream);
+vector<FraudAlert> findFraudulentTransactions(const Ledger &ledger);
+vector<FraudAlert> findRollingAnomalies(const Ledger &ledger, const RollingDetectorOptions &options);
 void detectFraudulentTransactions();
-void optimizeSavingsPlan(vector<tuple<int, int, string>> &nonEssentialExpensesWithDates, int &goal);
-double optimizeSavings(int &goal);
-vector<PaymentResult> optimizeCreditCardPayments(const vector<vector<pair<vector<int>, vector<int>>>> &expenseData,
-                                                 const vector<vector<pair<vector<int>, vector<int>>>> &cardid, vector<CreditCard> &cardVec, int availableFunds);
+void printFraudAlertTable(vector<FraudAlert> alerts);
+void printFraudAlert(const FraudAlert &alert);
+string fraudAlertJson(const Ledger &ledger, const FraudAlert &alert);
+void shiftOrScalar(uint64_t *reach, size_t words, int shift);
+void relaxCountsScalar(int *count, int target, int amount);
+#ifdef APS_X86_SIMD
+void shiftOrSSE2(uint64_t *reach, size_t words, int shift);
+void relaxCountsSSE2(int *count, int target, int amount);
+APS_TARGET_AVX2 void shiftOrAVX2(uint64_t *reach, size_t words, int shift);
+APS_TARGET_AVX2 void relaxCountsAVX2(int *count, int target, int amount);
+#endif
+vector<SubsetSumKernel> availableSubsetSumKernels();
+SubsetSumKernel &subsetSumKernel();
+void fillSavingsMatrix(const SavingsItem *items, int n, int goal, vector<int> &count, vector<uint64_t> &taken);
+void selectFromSavingsMatrix(const SavingsItem *items, int n, int total, const vector<uint64_t> &taken, vector<SavingsItem> &selected);
+SavingsResult optimizeSavingsMatrix(const SavingsItem *items, int n, int goal);
+void reachableSavings(const vector<SavingsItem> &items, int goal, vector<uint64_t> &reach);
+int bestReachableSavings(const vector<SavingsItem> &items, int goal);
+int highestReachable(const vector<uint64_t> &reach, int goal);
+void fewestEntryCounts(const SavingsItem *first, const SavingsItem *last, int target, vector<int> &count);
+void selectFewestEntries(const SavingsItem *first, const SavingsItem *last, int target, vector<SavingsItem> &selected);
+SavingsResult optimizeSavingsPlan(const vector<SavingsItem> &items, int goal);
+vector<SavingsItem> collectNonEssentialExpenses(const Ledger &ledger);
+const SavingsIndex &savingsIndexFor(const Ledger &ledger, int goal);
+SavingsResult optimizeSavings(const Ledger &ledger, int goal);
+const SavingsReach &savingsReachFor(Ledger &ledger, int goal);
+void displaySavingsResult(const SavingsResult &result);
+vector<PaymentResult> optimizeCreditCardPayments(const Ledger &ledger, vector<CreditCard> &cardVec, int availableFunds);
 void displayResults(const vector<PaymentResult> &results);
 int findMinTravelCost(const vector<City> &cities, const vector<vector<ERoute>> &graph, int source,
                       int destination, int numPeople, int numDays, vector<int> &parent);
+vector<string> travelPath(const vector<int> &parent, int source, int destination, const vector<City> &cities);
 void printPath(const vector<int> &parent, int source, int destination, const vector<City> &cities);
+void loadTravelNetwork(const string &networkFile, vector<City> &cities, vector<vector<ERoute>> &graph, unordered_map<string, int> &cityIndex);
 void travelExpenseMinimizer();
+EmergencyFundResult computeEmergencyFunds(const Ledger &ledger);
 void allocateEmergencyFunds();
 void initializeDisjointSet(int n);
 int findParent(int x);
@@ -221,16 +1010,36 @@ string compressData(const string &data, unordered_map<char, string> &huffmanCode
 string decompressData(const string &compressed, unordered_map<char, string> &huffmanCode);
 void encrypt(const string &inputFilename, const string &outputFilename, int key);
 void decrypt(const string &inputFilename, const string &outputFilename, int key);
-vector<LoanRepaymentResult> optimizeLoanRepayment(const vector<vector<pair<vector<int>, vector<int>>>> &expenseData,
-                                                  int income, int month, vector<Loan> &loans);
+vector<LoanRepaymentResult> optimizeLoanRepayment(const Ledger &ledger, int income, int year, int month, vector<Loan> &loans);
 void displayLoanResults(const vector<LoanRepaymentResult> &results);
 void optimizeInvestmentPortfolio(int totalRiskBudget);
 void generateBudgetPlan(double monthlyIncome);
 RentBuyResult rentVsBuyDecision(const RentBuyInput &input, double interestRate, double rentIncreaseRate);
-void runRentVsBuySimulator(vector<int> &monthlyTotals);
+void runRentVsBuySimulator();
 InventoryResult optimizeInventory(const vector<Product> &products, int capacity);
 void runInventoryOptimizer();
 SchedulerResult scheduleRecurringExpenses(const vector<RecurringBill> &bills, int income);
-void runRecurringExpenseScheduler(vector<int> &monthlyTotals);
+void runRecurringExpenseScheduler();
 void displayHeader();
+string jsonString(const string &text);
+vector<string> splitCommandLine(const string &line);
+BatchCommand parseBatchCommand(const vector<string> &tokens, int line);
+string batchStringOption(const BatchCommand &command, const string &name, const string &fallback, bool required = false);
+int batchIntOption(const BatchCommand &command, const string &name, int fallback, bool required = false);
+double batchDoubleOption(const BatchCommand &command, const string &name, double fallback, bool required = false);
+string runBatchCommand(const BatchCommand &command);
+int generateSyntheticLedger(const SyntheticLedgerSpec &spec, const string &expenseFile, const string &cardFile);
+void generateTravelNetwork(int cityCount, int routeCount, unsigned seed, const string &networkFile);
+vector<Product> generateProductCatalog(int productCount, unsigned seed);
+SyntheticLedgerSpec syntheticLedgerSpec(const BatchCommand &command);
+template <class Body>
+BenchmarkResult runBenchmark(const string &name, int iterations, long long items, Body body);
+int runGenerator(const BatchCommand &command, ostream &results);
+int runBenchmarks(const BatchCommand &command, int threadCount, ostream &results);
+vector<FraudScanTask> findScanLedgers(const string &directory);
+template <class Body>
+void runWorkStealing(size_t taskCount, int threadCount, Body body);
+string scanLedgerForFraud(const FraudScanTask &task, const RollingDetectorOptions &rolling, const IngestOptions &ingest, FraudScanTally &tally);
+int runFraudScan(const BatchCommand &command, int threadCount, const IngestOptions &ingest, ostream &results);
+int runHeadless(int argc, char *argv[]);
 #endif